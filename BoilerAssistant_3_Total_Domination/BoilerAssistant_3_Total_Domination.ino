@@ -30,8 +30,11 @@
  *      - Strengthened SystemData propagation across all modules
  *      - Standardized LCD capitalization rules
  *      - Expanded UI edit buffers for operator clarity
- *      - Improved exhaust smoothing pipeline
+ *      - Improved exhaust smoothing pipeline (ExhaustFilter.h)
  *      - Legacy compatibility shims for v2.2 → v3.x
+ *      - Deadline‑ordered cooperative scheduler (Scheduler.h)
+ *      - Per‑stage loop timing (LoopPerf.h → /api/perf, boiler/perf)
+ *      - Staged boot: control first, splash / WiFi / MQTT from loop()
  *
  *  Architectural Notes:
  *      - Main loop is strictly deterministic and non-blocking
@@ -59,8 +62,15 @@
 #include "FanControl.h"
 #include "Keypad_I2C.h"
 #include "Pinout.h"
+#include "Scheduler.h"
+#include "LoopPerf.h"
+#include "ControlMath.h"
+#include "SystemFields.h"
+#include "Telemetry.h"
+#include "TelemetryHistory.h"
 
 #include <WiFiS3.h>
+#include <FspTimer.h>
 #include "WiFiAPI.h"
 #include "MQTTClient.h"
 #include "WiFiProvisioning.h"
@@ -106,7 +116,6 @@ uint8_t globalRampProfile = 1;
 
 // UI state
 UIState uiState      = UI_HOME;
-bool    uiNeedRedraw = true;
 
 // UI edit buffers
 String newSetpointValue;
@@ -123,26 +132,264 @@ String envSeasonEditValue;
 String envSetpointEditValue;
 String envLockoutEditValue;
 
-/* Forward declarations */
-double exhaust_readF_cached();
+/* ============================================================
+ *  SCHEDULER TASKS
+ *  ------------------------------------------------------------
+ *  Task table (period / phase / budget):
+ *
+ *    control      250 ms /    0 ms /  2 ms   CRITICAL
+ *    keypad        20 ms /    5 ms /  3 ms   BACKGROUND
+ *    water         25 ms /   15 ms / 12 ms   BACKGROUND
+ *    env         3000 ms / 1500 ms /  8 ms   BACKGROUND
+ *    network       20 ms /   10 ms / 40 ms   BACKGROUND
+ *    ui           250 ms /  125 ms / 20 ms   BACKGROUND  (1000/UI_MAX_FPS)
+ *    provision     50 ms /   35 ms / 20 ms   BACKGROUND
+ *    storage      100 ms /   45 ms / 20 ms   BACKGROUND
+ *    diag       60000 ms /30000 ms / 20 ms   BACKGROUND
+ *
+ *  During an MQTT connect or DNS lookup the loop is parked in
+ *  the modem call; control then runs from the guard timer ISR
+ *  (CONTROL GUARD TIMER below), all other tasks simply wait.
+ *
+ *  The UI phase sits half a control period away from the
+ *  control tick so an LCD refresh never competes with it. Most
+ *  UI runs end after the display signature check: nothing is
+ *  formatted or sent unless a shown value or a key changed.
+ *
+ *  The water task is a short state machine step: it starts a
+ *  DS18B20 conversion every 500 ms and reads one probe per run
+ *  once the conversion time has elapsed (~11 ms of bus slots).
+ * ============================================================ */
+
+static int8_t uiTaskId = -1;
+
+// Exhaust pipeline → burn engine → fan output → SystemData
+static void task_control(unsigned long now) {
+    // Exhaust pipeline: one filter step per fresh MAX31855 sample
+    // (sys.exhaustRawF → Guardian, sys.exhaustSmoothF → control)
+    perf_begin(PERF_EXHAUST);
+    exhaust_poll();
+    perf_end(PERF_EXHAUST);
+
+    if (!isnan(sys.exhaustSmoothF)) {
+        smoothExh = (int16_t)sys.exhaustSmoothF;
+    }
+
+    perf_begin(PERF_BURN);
+    int demand = burnengine_compute();
+    perf_end(PERF_BURN);
+
+    // Fan control (single source of truth)
+    perf_begin(PERF_FAN);
+    int fanPercent = fancontrol_apply(demand);
+    lastFanPercent = fanPercent;
+
+    int pwm = map(fanPercent, 0, 100, 0, 255);
+    analogWrite(PIN_FAN_PWM, pwm);
+    perf_end(PERF_FAN);
+
+    // Minimal shims: keep these globals in sync for any legacy users
+    controlMode       = sys.controlMode;
+    tankLowSetpointF  = sys.tankLowSetpointF;
+    tankHighSetpointF = sys.tankHighSetpointF;
+
+    sysf_setI(SF_FAN_FINAL, fanPercent);
+
+    // Persist pending edits at burn-state transitions
+    if (sys.burnState != burnState) eeprom_requestCommit();
+
+    // Mirror from sys → legacy globals (never the other way)
+    burnState   = sys.burnState;
+    safetyState = sys.safetyState;
+
+    sys.uptimeMs = now;
 
-/* Local implementation of exhaust smoothing */
-double smoothExhaustF(double rawF) {
-    if (isnan(sys.exhaustSmoothF)) {
-        sys.exhaustSmoothF = rawF;
-    } else {
-        sys.exhaustSmoothF = sys.exhaustSmoothF * 0.8 + rawF * 0.2;
+    // Publish one consistent view for MQTT / HTTP / LoRa / home screen
+    telemetry_capture(now);
+}
+
+static void task_keypad(unsigned long now) {
+    perf_begin(PERF_KEYPAD);
+    char k = keypad_read();
+    if (!k) {
+        perf_end(PERF_KEYPAD);
+        return;
+    }
+
+    ui_handleKey(k, smoothExh, lastFanPercent);   // sets sys.uiNeedsRefresh
+    telemetry_capture(now);                        // operator edits / Guardian reset
+    perf_end(PERF_KEYPAD);
+
+    // Render the result of the key press on the next pass
+    sched_trigger(uiTaskId);
+}
+
+// One DS18B20 state machine step: start / wait / read one probe
+static void task_waterProbes(unsigned long now) {
+    perf_begin(PERF_WATER);
+    if (sensors_pollWaterProbes()) {
+        telemetry_capture(now);    // fresh probe value
+    }
+    perf_end(PERF_WATER);
+}
+
+static void task_environment(unsigned long now) {
+    perf_begin(PERF_ENV);
+    sensors_readBME280();
+    telemetry_capture(now);
+    perf_end(PERF_ENV);
+}
+
+// WiFi + MQTT (only once STA association has finished)
+static void task_network(unsigned long now) {
+    static bool started = false;
+
+    // Outage history runs in every provisioning state, AP included
+    history_poll(now, !mqtt_outage());
+
+    if (!wifi_prov_staReady()) return;
+
+    // Last boot phase: API + MQTT come up behind control and WiFi
+    if (!started) {
+        started = true;
+        perf_begin(PERF_WIFIAPI);
+        wifiapi_init();
+        mqtt_init();
+        perf_end(PERF_WIFIAPI);
+        return;
     }
-    return sys.exhaustSmoothF;
+
+    perf_begin(PERF_WIFIAPI);
+    wifiapi_loop();
+    perf_end(PERF_WIFIAPI);
+
+    perf_begin(PERF_MQTT);
+    mqtt_loop();
+    perf_end(PERF_MQTT);
+}
+
+static void task_ui(unsigned long now) {
+    perf_begin(PERF_UI);
+    ui_update(now, smoothExh, lastFanPercent);
+    perf_end(PERF_UI);
+}
+
+// Provisioning AP handler
+static void task_provisioning(unsigned long now) {
+    perf_begin(PERF_PROVISION);
+    wifi_prov_loop();
+    perf_end(PERF_PROVISION);
+}
+
+// Deferred EEPROM commits, a few bytes per run
+static void task_storage(unsigned long now) {
+    eeprom_poll(now);
+}
+
+static void task_diagnostics(unsigned long now) {
+    sched_printReport(Serial);
 }
 
 /* ============================================================
  *  SETUP
  * ============================================================ */
 
+/* ============================================================
+ *  BURN ENGINE BENCHMARK (optional)
+ *  ------------------------------------------------------------
+ *  Build with -DBA_BENCH_BURNENGINE to print the cost of one
+ *  burnengine_compute() call at boot. Sweeps the exhaust across
+ *  RAMP and HOLD (both fan modes), then restores sys.* and the
+ *  fan ramp state. Compare builds with CTL_MATH_MODE = 0 / 1 / 2.
+ * ============================================================ */
+#ifdef BA_BENCH_BURNENGINE
+static void bench_burnengine() {
+    const uint16_t ITER = 1000;
+
+    SystemData saved = sys;
+    uint32_t totalCycles = 0;
+    uint32_t totalUs     = 0;
+
+    sys.controlMode = RUNMODE_CONTINUOUS;   // no tank‑driven IDLE exits
+
+    for (uint8_t pass = 0; pass < 3; pass++) {
+        sys.burnState       = (pass == 0) ? BURN_RAMP : BURN_HOLD;
+        sys.deadzoneFanMode = (pass == 2) ? 1 : 0;
+
+        for (uint16_t i = 0; i < ITER; i++) {
+            sys.exhaustSmoothF = sys.exhaustSetpoint - 210 + (i % 230) + 0.37f;
+            sys.exhaustRawF    = sys.exhaustSmoothF;
+            if (pass > 0) sys.burnState = BURN_HOLD;
+
+            uint32_t t0 = perf_timestamp();
+            burnengine_compute();
+            totalCycles += perf_elapsedCycles(t0);
+            totalUs     += perf_elapsedUs(t0);
+        }
+    }
+
+    sys = saved;
+    fancontrol_init();
+    digitalWrite(PIN_DAMPER, HIGH);   // back to CLOSED
+
+    Serial.print("[BENCH] burnengine_compute (");
+    Serial.print(CTL_MATH_NAME);
+    Serial.print("): ");
+    Serial.print(totalCycles / (3UL * ITER));
+    Serial.print(" cycles, ");
+    Serial.print((float)totalUs / (3.0f * ITER), 2);
+    Serial.println(" us/call");
+}
+#endif
+
+/* ============================================================
+ *  CONTROL GUARD TIMER
+ *  ------------------------------------------------------------
+ *  Periodic ISR at SCHED_SERVICE_HZ. Outside a scheduler
+ *  blocking section it returns at once; inside one (MQTT
+ *  connect / DNS) it runs task_control on its normal grid.
+ *  Lowest priority, so the modem UART, SPI and millis()
+ *  interrupts still preempt the control step.
+ * ============================================================ */
+#define CONTROL_GUARD_IRQ_PRIORITY 14
+
+static FspTimer controlGuardTimer;
+
+static void controlGuardIsr(timer_callback_args_t*) {
+    sched_serviceCritical();
+}
+
+static void controlGuard_init() {
+    uint8_t type;
+    int8_t  channel = FspTimer::get_available_timer(type);
+
+    if (channel < 0 ||
+        !controlGuardTimer.begin(TIMER_MODE_PERIODIC, type, channel,
+                                 (float)SCHED_SERVICE_HZ, 0.0f, controlGuardIsr) ||
+        !controlGuardTimer.setup_overflow_irq(CONTROL_GUARD_IRQ_PRIORITY) ||
+        !controlGuardTimer.open() ||
+        !controlGuardTimer.start()) {
+        Serial.println("Boot: no timer for the control guard, MQTT connects will stall control");
+    }
+}
+
+/* ============================================================
+ *  BOOT
+ *  ------------------------------------------------------------
+ *  setup() only does the control‑critical phase: pins, EEPROM,
+ *  sensors, burn engine, fan, keypad, LCD init. Everything slow
+ *  runs later from loop() through the scheduler:
+ *
+ *    ui         boot screen, then the normal UI
+ *    provision  STA association (AP fallback after 8 s)
+ *    network    WiFiAPI + MQTT init once STA is up
+ *
+ *  The first control tick runs straight after setup(); the
+ *  damper and fan are under control within a few hundred ms of
+ *  power‑up instead of after the splash and WiFi join.
+ * ============================================================ */
 void setup() {
     Serial.begin(115200);
-    delay(500);
 
     pinMode(PIN_DAMPER, OUTPUT);
     digitalWrite(PIN_DAMPER, HIGH);   // default CLOSED
@@ -152,6 +399,8 @@ void setup() {
     Serial.println();
     Serial.println("=== Boiler Assistant v3.0 Boot ===");
 
+    perf_init();
+
     Wire.begin();
     Wire.setClock(400000);
 
@@ -174,15 +423,39 @@ void setup() {
     keypad_init(Wire);
     ui_init();
 
-    // Provisioning: STA-first, AP-fallback
-    wifi_prov_init();
+#ifdef BA_BENCH_BURNENGINE
+    bench_burnengine();
+#endif
 
-    if (!wifi_prov_isAPMode()) {
-        wifiapi_init();
-        mqtt_init();
-    }
+    // Provisioning: STA-first, AP-fallback (association is stepped
+    // by the provision task; WiFiAPI / MQTT start from the network task)
+    wifi_prov_init();
 
     burnengine_startBoost();
+
+    // Task table (see SCHEDULER TASKS above)
+    sched_addTask("control",     task_control,      250,     0,  2000, SCHED_CRITICAL);
+    sched_addTask("keypad",      task_keypad,        20,     5,  3000, SCHED_BACKGROUND);
+    sched_addTask("water",       task_waterProbes,   25,    15, 12000, SCHED_BACKGROUND);
+    sched_addTask("env",         task_environment, 3000,  1500,  8000, SCHED_BACKGROUND);
+    sched_addTask("network",     task_network,       20,    10, 40000, SCHED_BACKGROUND);
+    uiTaskId =
+    sched_addTask("ui",          task_ui, 1000 / UI_MAX_FPS,   125, 20000, SCHED_BACKGROUND);
+    sched_addTask("provision",   task_provisioning,  50,    35, 20000, SCHED_BACKGROUND);
+    sched_addTask("storage",     task_storage,      100,    45, 20000, SCHED_BACKGROUND);
+    sched_addTask("diag",        task_diagnostics, 60000, 30000, 20000, SCHED_BACKGROUND);
+
+    // Change tracking starts from the fully loaded state
+    sysf_init();
+
+    Serial.print("Boot: control online at ");
+    Serial.print(millis());
+    Serial.println(" ms");
+
+    sched_start(millis());
+
+    // After fancontrol_init(): the fan PWM has claimed its GPT channel
+    controlGuard_init();
 }
 
 /* ============================================================
@@ -190,70 +463,5 @@ void setup() {
  * ============================================================ */
 
 void loop() {
-
-    unsigned long now = millis();
-
-    // 0) Keypad
-    char k = keypad_read();
-    if (k) {
-        double rawExhKey = exhaust_readF_cached();
-        smoothExh = (int16_t)smoothExhaustF(rawExhKey);
-        ui_handleKey(k, smoothExh, lastFanPercent);
-        uiNeedRedraw = true;
-    }
-
-    // 1) Sensors
-    static unsigned long lastBME = 0;
-    if (now - lastBME > 3000) {
-        sensors_readBME280();
-        lastBME = now;
-    }
-
-    static unsigned long lastWaterRead = 0;
-    if (now - lastWaterRead > 500) {
-        sensors_readWaterProbes();
-        lastWaterRead = now;
-    }
-
-    // 2) Burn engine – exhaust pipeline
-    double rawExh = exhaust_readF_cached();
-    sys.exhaustRawF = rawExh;                    // live raw flue temp for Guardian
-    smoothExh = (int16_t)smoothExhaustF(rawExh);
-    sys.exhaustSmoothF = smoothExh;             // live smoothed flue temp for control
-
-    int demand = burnengine_compute();
-
-    // 3) Fan control (single source of truth)
-    int fanPercent = fancontrol_apply(demand);
-    lastFanPercent = fanPercent;
-
-    int pwm = map(fanPercent, 0, 100, 0, 255);
-    analogWrite(PIN_FAN_PWM, pwm);
-
-    // 4) Update SystemData snapshot for UI / WiFi / MQTT
-
-    // Minimal shims: keep these globals in sync for any legacy users
-    controlMode       = sys.controlMode;
-    tankLowSetpointF  = sys.tankLowSetpointF;
-    tankHighSetpointF = sys.tankHighSetpointF;
-
-    sys.fanFinal = fanPercent;
-
-    // Mirror from sys → legacy globals (never the other way)
-    burnState   = sys.burnState;
-    safetyState = sys.safetyState;
-
-    sys.uptimeMs = now;
-
-    // 5) WiFi + MQTT (only when NOT in AP mode)
-    if (!wifi_prov_isAPMode()) {
-        wifiapi_loop();
-        mqtt_loop();
-    }
-
-    // 6) UI
-    ui_showScreen(uiState, smoothExh, fanPercent);
-
-    // 7) Provisioning AP handler
-    wifi_prov_loop();
+    sched_run();
 }
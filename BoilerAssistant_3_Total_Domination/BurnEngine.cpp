@@ -31,6 +31,8 @@
  *      - SystemData is the single source of truth for all parameters
  *      - Dampers and fan outputs are applied only through this module
  *      - All timing uses millis() and remains strictly non‑blocking
+ *      - Demand math goes through ControlMath.h (float / Q15.16 on
+ *        the RA4M1 instead of software‑emulated double)
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -43,6 +45,7 @@
 #include "FanControl.h"
 #include "Sensors.h"
 #include "Pinout.h"
+#include "ControlMath.h"
 
 extern SystemData sys;
 
@@ -51,7 +54,7 @@ extern SystemData sys;
  * ============================================================ */
 static int burnengine_computeAutoTank();
 static int burnengine_computeContinuous();
-static int burnengine_computeHoldDemand(double exhaustControlF,
+static int burnengine_computeHoldDemand(ctl_t exhaustControlF,
                                         unsigned long now);
 
 /* ============================================================
@@ -110,22 +113,18 @@ int burnengine_compute() {
  *  HEAT-DEMAND HOLD DEMAND (v2.3-style)
  *  COLDER → MORE fan, HOTTER → LESS fan
  * ============================================================ */
-static int burnengine_computeHoldDemand(double exhaustControlF,
+static int burnengine_computeHoldDemand(ctl_t exhaustControlF,
                                         unsigned long now)
 {
-    if (isnan(exhaustControlF)) return 0;
+    if (ctl_isnan(exhaustControlF)) return 0;
 
-    double bandHalf = sys.deadbandF / 2.0;
-    if (bandHalf <= 0) bandHalf = 1.0;
-
-    double low  = sys.exhaustSetpoint - bandHalf;
-    double high = sys.exhaustSetpoint + bandHalf;
+    CtlBand band = ctl_holdBand(sys.exhaustSetpoint, sys.deadbandF);
 
     /* ============================================================
      *  ⭐ NEW FIX: EXIT HOLD → RAMP WHEN EXHAUST DROPS BELOW BAND
      * ============================================================ */
     if (sys.burnState == BURN_HOLD &&
-    exhaustControlF < low)
+    exhaustControlF < band.low)
     {
         sys.burnState = BURN_RAMP;
         holdLocked = false;
@@ -145,61 +144,19 @@ static int burnengine_computeHoldDemand(double exhaustControlF,
 
     /* ============================================================
      *  MODE 1: FAN ALWAYS ON (UI option 1)
-     * ============================================================ */
-    if (sys.deadzoneFanMode == 1) {
-        if (exhaustControlF <= low) {
-            return sys.clampMaxPercent;   // COLD → MORE FAN
-        }
-        if (exhaustControlF >= high) {
-            return sys.clampMinPercent;   // HOT → LESS FAN
-        }
-
-        long d = map((long)exhaustControlF,
-                     (long)low, (long)high,
-                     (long)sys.clampMaxPercent,
-                     (long)sys.clampMinPercent);
-        return (int)d;
-    }
-
-    /* ============================================================
      *  MODE 0: FAN ALLOWED OFF (UI option 2)
      * ============================================================ */
-    if (sys.deadzoneFanMode == 0) {
-
-        // In band → OFF
-        if (exhaustControlF >= low && exhaustControlF <= high) {
-            return 0;
-        }
-
-        // Below band → ramp up toward 100%
-        if (exhaustControlF < low) {
-            double span = bandHalf;
-            double e    = low - exhaustControlF;
-            if (e >= span) return 100;
-            double pct = (double)sys.clampMaxPercent * (e / span);
-            if (pct < sys.clampMinPercent) pct = sys.clampMinPercent;
-            return (int)pct;
-        }
-
-        // Above band → ramp down toward 0
-        if (exhaustControlF > high) {
-            double span = bandHalf;
-            double e    = exhaustControlF - high;
-            if (e >= span) return 0;
-            double pct = (double)sys.clampMinPercent * (1.0 - (e / span));
-            if (pct < 0) pct = 0;
-            return (int)pct;
-        }
-    }
-
-    return 0;
+    return ctl_holdDemand(exhaustControlF, band,
+                          sys.deadzoneFanMode,
+                          sys.clampMinPercent,
+                          sys.clampMaxPercent);
 }
 
 /* ============================================================
  *  SHARED GUARDIAN + DAMPER + FAN APPLY
  * ============================================================ */
 static int burnengine_finalize(int demand,
-                               double exhaustGuardF,
+                               float exhaustGuardF,
                                unsigned long now)
 {
     /* EMBER GUARDIAN TIMER + LATCH */
@@ -280,13 +237,13 @@ static int burnengine_finalize(int demand,
 static int burnengine_computeAutoTank() {
     unsigned long now = millis();
 
-    double exhaustControlF = sys.exhaustSmoothF;
-    double exhaustGuardF   = sys.exhaustRawF;
+    ctl_t exhaustControlF = ctl_fromFloat(sys.exhaustSmoothF);
+    float exhaustGuardF   = sys.exhaustRawF;
 
     int tankIndex = (sys.probeRoleMap[PROBE_TANK] < sys.waterProbeCount)
                     ? sys.probeRoleMap[PROBE_TANK]
                     : 0;
-    double tankF = sys.waterTempF[tankIndex];
+    float tankF = sys.waterTempF[tankIndex];
 
     /* AUTO START */
     if (sys.burnState == BURN_IDLE) {
@@ -331,8 +288,8 @@ static int burnengine_computeAutoTank() {
             sys.rampStartMs     = now;
         }
 
-        if (!isnan(exhaustControlF) &&
-            exhaustControlF >= (sys.exhaustSetpoint - 25))
+        if (!ctl_isnan(exhaustControlF) &&
+            exhaustControlF >= ctl_fromInt(sys.exhaustSetpoint - 25))
         {
             sys.burnState       = BURN_HOLD;
             sys.holdTimerActive = true;
@@ -352,23 +309,9 @@ static int burnengine_computeAutoTank() {
             break;
 
         case BURN_RAMP:
-            if (isnan(exhaustControlF)) {
-                demand = 0;
-            } else {
-                double low  = sys.exhaustSetpoint - 200.0;
-                double high = sys.exhaustSetpoint;
-                if (exhaustControlF <= low) {
-                    demand = 100;
-                } else if (exhaustControlF >= high) {
-                    demand = sys.clampMinPercent;
-                } else {
-                    long d = map((long)exhaustControlF,
-                                 (long)low, (long)high,
-                                 100L,
-                                 (long)sys.clampMinPercent);
-                    demand = (int)d;
-                }
-            }
+            demand = ctl_rampDemand(exhaustControlF,
+                                    sys.exhaustSetpoint,
+                                    sys.clampMinPercent);
             break;
 
         case BURN_HOLD:
@@ -390,8 +333,8 @@ static int burnengine_computeAutoTank() {
 static int burnengine_computeContinuous() {
     unsigned long now = millis();
 
-    double exhaustControlF = sys.exhaustSmoothF;
-    double exhaustGuardF   = sys.exhaustRawF;
+    ctl_t exhaustControlF = ctl_fromFloat(sys.exhaustSmoothF);
+    float exhaustGuardF   = sys.exhaustRawF;
 
     /* BOOST → RAMP */
     if (sys.burnState == BURN_BOOST) {
@@ -413,8 +356,8 @@ static int burnengine_computeContinuous() {
             sys.rampStartMs     = now;
         }
 
-        if (!isnan(exhaustControlF) &&
-            exhaustControlF >= (sys.exhaustSetpoint - 25))
+        if (!ctl_isnan(exhaustControlF) &&
+            exhaustControlF >= ctl_fromInt(sys.exhaustSetpoint - 25))
         {
             sys.burnState       = BURN_HOLD;
             sys.holdTimerActive = true;
@@ -434,23 +377,9 @@ static int burnengine_computeContinuous() {
             break;
 
         case BURN_RAMP:
-            if (isnan(exhaustControlF)) {
-                demand = 0;
-            } else {
-                double low  = sys.exhaustSetpoint - 200.0;
-                double high = sys.exhaustSetpoint;
-                if (exhaustControlF <= low) {
-                    demand = 100;
-                } else if (exhaustControlF >= high) {
-                    demand = sys.clampMinPercent;
-                } else {
-                    long d = map((long)exhaustControlF,
-                                 (long)low, (long)high,
-                                 100L,
-                                 (long)sys.clampMinPercent);
-                    demand = (int)d;
-                }
-            }
+            demand = ctl_rampDemand(exhaustControlF,
+                                    sys.exhaustSetpoint,
+                                    sys.clampMinPercent);
             break;
 
         case BURN_HOLD:
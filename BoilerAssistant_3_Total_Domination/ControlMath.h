@@ -0,0 +1,275 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Control Math Kernel (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: ControlMath.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Numeric type and pure demand functions for the exhaust → fan
+ *    control path. The Cortex‑M4F in the UNO R4 has a single‑
+ *    precision FPU only, so every `double` operation in the burn
+ *    engine used to be a software‑emulated library call.
+ *
+ *    The representation is selected at compile time:
+ *
+ *      CTL_MATH_MODE = CTL_MATH_DOUBLE  → double   (v3.0 reference)
+ *      CTL_MATH_MODE = CTL_MATH_FLOAT   → float    (default, FPU)
+ *      CTL_MATH_MODE = CTL_MATH_FIXED   → Q15.16 in int32_t
+ *
+ *    Fixed‑point notes:
+ *      - Range ±32767 °F, resolution 1/65536 °F
+ *      - NaN is carried as INT32_MIN (CTL_NAN)
+ *      - Float → Q15.16 conversion floors, so integer truncation
+ *        of the result matches (long) casts of the source value
+ *      - Ratios are computed as (k · num) / den in 64‑bit to avoid
+ *        an intermediate rounding step
+ *
+ *    Equivalence against the double reference and host timings:
+ *      host/control_math_equiv (see host/CMakeLists.txt)
+ *
+ *  Architectural Notes:
+ *      - Header‑only, no Arduino dependency (builds on the host)
+ *      - Functions are pure: no SystemData access, no side effects
+ *      - ctl_map() is bit‑identical to Arduino's long map()
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef CONTROL_MATH_H
+#define CONTROL_MATH_H
+
+#include <stdint.h>
+#include <math.h>
+
+/* ============================================================
+ *  MODE SELECTION
+ * ============================================================ */
+#define CTL_MATH_DOUBLE 0
+#define CTL_MATH_FLOAT  1
+#define CTL_MATH_FIXED  2
+
+#ifndef CTL_MATH_MODE
+#define CTL_MATH_MODE CTL_MATH_FLOAT
+#endif
+
+/*
+ * Mode 0 ratios that land within CTL_TIE_EPS of a whole percent are
+ * re-evaluated with the v3.0 double expression. There the exact value
+ * is (or nearly is) an integer and only the reference's own rounding
+ * decides which side truncation falls on (10 × (1 − 4.5/5) → 0.99…,
+ * so 0 %, where exact math gives 1 % and clampMin). Float error is
+ * ~1e‑5 at k = 100, so anything further out truncates identically.
+ * The double path runs for well under 1 % of out‑of‑band calls.
+ */
+#define CTL_TIE_EPS 1e-3f
+
+/* ============================================================
+ *  NUMERIC TYPE
+ * ============================================================ */
+#if CTL_MATH_MODE == CTL_MATH_DOUBLE
+
+typedef double ctl_t;
+#define CTL_MATH_NAME "double"
+
+static inline ctl_t ctl_fromFloat(float f)     { return (double)f; }
+static inline ctl_t ctl_fromInt(long v)        { return (double)v; }
+static inline ctl_t ctl_half(long v)           { return (double)v / 2.0; }
+static inline bool  ctl_isnan(ctl_t x)         { return isnan(x); }
+static inline long  ctl_toLong(ctl_t x)        { return (long)x; }
+
+// k · (num / den), evaluated in the same order as the v3.0 code
+static inline ctl_t ctl_scale(long k, ctl_t num, ctl_t den) {
+    return (double)k * (num / den);
+}
+
+// k · (1 − num / den)
+static inline ctl_t ctl_scaleRem(long k, ctl_t num, ctl_t den) {
+    return (double)k * (1.0 - (num / den));
+}
+
+#elif CTL_MATH_MODE == CTL_MATH_FLOAT
+
+typedef float ctl_t;
+#define CTL_MATH_NAME "float"
+
+static inline ctl_t ctl_fromFloat(float f)     { return f; }
+static inline ctl_t ctl_fromInt(long v)        { return (float)v; }
+static inline ctl_t ctl_half(long v)           { return (float)v * 0.5f; }
+static inline bool  ctl_isnan(ctl_t x)         { return isnan(x); }
+static inline long  ctl_toLong(ctl_t x)        { return (long)x; }
+
+static inline bool ctl_nearWhole(float pct) {
+    float frac = pct - floorf(pct);
+    return frac < CTL_TIE_EPS || frac > 1.0f - CTL_TIE_EPS;
+}
+
+static inline ctl_t ctl_scale(long k, ctl_t num, ctl_t den) {
+    float pct = (float)k * (num / den);
+    if (!ctl_nearWhole(pct)) return pct;
+    return (float)(long)((double)k * ((double)num / (double)den));
+}
+
+static inline ctl_t ctl_scaleRem(long k, ctl_t num, ctl_t den) {
+    float pct = (float)k * (1.0f - (num / den));
+    if (!ctl_nearWhole(pct)) return pct;
+    return (float)(long)((double)k * (1.0 - ((double)num / (double)den)));
+}
+
+#elif CTL_MATH_MODE == CTL_MATH_FIXED
+
+typedef int32_t ctl_t;
+#define CTL_MATH_NAME "q16"
+
+#define CTL_FRAC_BITS 16
+#define CTL_ONE       ((int32_t)1 << CTL_FRAC_BITS)
+#define CTL_NAN       INT32_MIN
+
+static inline ctl_t ctl_fromFloat(float f) {
+    if (isnan(f)) return CTL_NAN;
+    if (f >=  32767.0f) return  (int32_t)32767 * CTL_ONE;
+    if (f <= -32767.0f) return -(int32_t)32767 * CTL_ONE;
+    return (int32_t)floorf(f * (float)CTL_ONE);
+}
+
+static inline ctl_t ctl_fromInt(long v)        { return (int32_t)(v * CTL_ONE); }
+static inline ctl_t ctl_half(long v)           { return (int32_t)(v * (CTL_ONE / 2)); }
+static inline bool  ctl_isnan(ctl_t x)         { return x == CTL_NAN; }
+
+// Truncation toward zero, like a (long) cast of a double
+static inline long ctl_toLong(ctl_t x) {
+    return (x >= 0) ? (long)(x >> CTL_FRAC_BITS)
+                    : -(long)((-x) >> CTL_FRAC_BITS);
+}
+
+#define CTL_TIE_Q16   ((int32_t)(CTL_TIE_EPS * CTL_ONE))
+
+static inline bool ctl_nearWhole(ctl_t pct) {
+    int32_t frac = pct & (CTL_ONE - 1);
+    return frac < CTL_TIE_Q16 || frac > CTL_ONE - CTL_TIE_Q16;
+}
+
+static inline double ctl_toDouble(ctl_t x) { return (double)x / CTL_ONE; }
+
+static inline ctl_t ctl_scale(long k, ctl_t num, ctl_t den) {
+    ctl_t pct = (int32_t)(((int64_t)k * num * CTL_ONE) / den);
+    if (!ctl_nearWhole(pct)) return pct;
+    return ctl_fromInt((long)((double)k * (ctl_toDouble(num) / ctl_toDouble(den))));
+}
+
+static inline ctl_t ctl_scaleRem(long k, ctl_t num, ctl_t den) {
+    ctl_t pct = (int32_t)(((int64_t)k * (den - num) * CTL_ONE) / den);
+    if (!ctl_nearWhole(pct)) return pct;
+    return ctl_fromInt((long)((double)k * (1.0 - ctl_toDouble(num) / ctl_toDouble(den))));
+}
+
+#else
+#error "CTL_MATH_MODE must be CTL_MATH_DOUBLE, CTL_MATH_FLOAT or CTL_MATH_FIXED"
+#endif
+
+/* ============================================================
+ *  INTEGER MAP (identical to Arduino map())
+ * ============================================================ */
+static inline long ctl_map(long x, long inMin, long inMax,
+                           long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+/* ============================================================
+ *  HOLD BAND
+ *  Band of ±deadband/2 around the exhaust setpoint.
+ *  A non‑positive deadband falls back to ±1 °F.
+ * ============================================================ */
+struct CtlBand {
+    ctl_t half;
+    ctl_t low;
+    ctl_t high;
+};
+
+static inline CtlBand ctl_holdBand(int setpointF, int deadbandF) {
+    CtlBand b;
+    b.half = ctl_half(deadbandF);
+    if (b.half <= ctl_fromInt(0)) b.half = ctl_fromInt(1);
+
+    b.low  = ctl_fromInt(setpointF) - b.half;
+    b.high = ctl_fromInt(setpointF) + b.half;
+    return b;
+}
+
+/* ============================================================
+ *  RAMP DEMAND
+ *  setpoint − 200 °F → 100 %, setpoint → clampMin
+ * ============================================================ */
+static inline int ctl_rampDemand(ctl_t exhaustF, int setpointF,
+                                 int clampMinPercent)
+{
+    if (ctl_isnan(exhaustF)) return 0;
+
+    ctl_t low  = ctl_fromInt(setpointF - 200);
+    ctl_t high = ctl_fromInt(setpointF);
+
+    if (exhaustF <= low)  return 100;
+    if (exhaustF >= high) return clampMinPercent;
+
+    return (int)ctl_map(ctl_toLong(exhaustF),
+                        setpointF - 200L, (long)setpointF,
+                        100L, (long)clampMinPercent);
+}
+
+/* ============================================================
+ *  HOLD DEMAND (inside or beyond the band)
+ *  COLDER → MORE fan, HOTTER → LESS fan
+ *
+ *  Mode 1: fan always on, interpolated clampMax → clampMin
+ *  Mode 0: fan off in band, proportional ramps outside
+ * ============================================================ */
+static inline int ctl_holdDemand(ctl_t exhaustF, const CtlBand& b,
+                                 uint8_t fanMode,
+                                 int clampMinPercent,
+                                 int clampMaxPercent)
+{
+    if (ctl_isnan(exhaustF)) return 0;
+
+    if (fanMode == 1) {
+        if (exhaustF <= b.low)  return clampMaxPercent;
+        if (exhaustF >= b.high) return clampMinPercent;
+
+        return (int)ctl_map(ctl_toLong(exhaustF),
+                            ctl_toLong(b.low), ctl_toLong(b.high),
+                            (long)clampMaxPercent,
+                            (long)clampMinPercent);
+    }
+
+    if (fanMode == 0) {
+
+        // In band → OFF
+        if (exhaustF >= b.low && exhaustF <= b.high) {
+            return 0;
+        }
+
+        // Below band → ramp up toward 100%
+        if (exhaustF < b.low) {
+            ctl_t e = b.low - exhaustF;
+            if (e >= b.half) return 100;
+            ctl_t pct = ctl_scale(clampMaxPercent, e, b.half);
+            if (pct < ctl_fromInt(clampMinPercent)) pct = ctl_fromInt(clampMinPercent);
+            return (int)ctl_toLong(pct);
+        }
+
+        // Above band → ramp down toward 0
+        ctl_t e = exhaustF - b.high;
+        if (e >= b.half) return 0;
+        ctl_t pct = ctl_scaleRem(clampMinPercent, e, b.half);
+        if (pct < ctl_fromInt(0)) pct = ctl_fromInt(0);
+        return (int)ctl_toLong(pct);
+    }
+
+    return 0;
+}
+
+#endif
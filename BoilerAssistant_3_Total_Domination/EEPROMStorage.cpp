@@ -18,15 +18,44 @@
  *      • Probe role mapping
  *      • Runtime WiFi credentials
  *
- *    Implements deterministic read/write helpers for multibyte
- *    values and enforces strict safety clamps to prevent invalid
- *    EEPROM data from destabilizing the burn engine.
+ *    All settings live in one packed ConfigBlob. eeprom_init()
+ *    loads it with a single bulk read, checks its CRC32 and copies
+ *    it into sys.*; safety clamps then reject values that are
+ *    valid bytes but unsafe settings.
+ *
+ *    Write coalescing:
+ *      The save functions only update a RAM shadow of the blob and
+ *      mark it dirty. The blob is committed by eeprom_poll() once
+ *      no save has happened for EEPROM_QUIET_MS (or
+ *      EEPROM_MAX_DEFER_MS after the first unsaved change), on
+ *      eeprom_requestCommit() (burn‑state transitions), or
+ *      synchronously by eeprom_commit() before a reset. A slider
+ *      drag costs one commit instead of dozens of data‑flash
+ *      erase/program cycles.
+ *
+ *    Wear leveling:
+ *      Commits rotate over EEPROM_SLOT_COUNT slots, each holding a
+ *      header { magic, seq, len, version, crc32 } and one blob. The
+ *      blob is written first and the header last, so a commit torn
+ *      by a power loss fails its CRC and the previous slot wins. At
+ *      boot the valid slot with the highest seq is loaded.
+ *
+ *    Schema migration:
+ *      Older layouts are upgraded in place, one version at a time,
+ *      by the functions registered in migrations[]. Version 2 is
+ *      the v2.x fixed‑offset layout, found either in a slot or
+ *      in place at offset 0 on units that never committed a slot.
  *
  *  Architectural Notes:
  *      - SystemData is the single source of truth for all fields.
- *      - EEPROM layout is fixed and version-stable.
- *      - All multibyte values use explicit little-endian encoding.
+ *      - Layout changes bump EEPROM_CONFIG_VERSION and add one
+ *        migration; existing versions are never edited.
+ *      - All multibyte values are little-endian (native on the
+ *        RA4M1 and on the host build).
  *      - This module contains no UI or control logic.
+ *      - Commits are written EEPROM_COMMIT_CHUNK bytes per poll
+ *        from a staging copy, so flash latency never lands on the
+ *        MQTT / keypad command path.
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -42,77 +71,342 @@ extern SystemData sys;
 extern RuntimeCredentials runtimeCreds;
 
 /* ============================================================
- *  INTERNAL HELPERS FOR MULTIBYTE VALUES
+ *  CONFIG BLOB (EEPROM_CONFIG_VERSION)
+ * ============================================================ */
+
+#define ENV_SEASONS     4       // indexed by EnvSeason (summer .. extreme)
+
+struct __attribute__((packed)) ConfigBlob {
+    /* Combustion */
+    int16_t  exhaustSetpoint;
+    int16_t  boostTimeSeconds;
+    int16_t  deadbandF;
+    int16_t  clampMinPercent;
+    int16_t  clampMaxPercent;
+    uint8_t  deadzoneFanMode;
+
+    /* Ember Guardian */
+    int16_t  emberGuardianMinutes;
+    int16_t  flueLowThreshold;
+    int16_t  flueRecoveryThreshold;
+
+    /* Environmental logic */
+    uint8_t  envSeasonMode;
+    uint8_t  envAutoSeason;
+    uint8_t  envLockoutHours;
+    int16_t  envStartF[ENV_SEASONS];
+    int16_t  envHystF[ENV_SEASONS];
+    int16_t  envSetpointF[ENV_SEASONS];
+    int16_t  envTankHighF[ENV_SEASONS];
+    int16_t  envTankLowF[ENV_SEASONS];
+    uint8_t  envClampMaxPercent[ENV_SEASONS];
+
+    /* Boiler control */
+    int16_t  tankLowSetpointF;
+    int16_t  tankHighSetpointF;
+    uint8_t  runMode;
+
+    /* Probe roles */
+    uint8_t  probeRoleMap[PROBE_ROLE_COUNT];
+
+    /* Runtime credentials (raw bytes; the struct is not POD) */
+    uint8_t  creds[sizeof(RuntimeCredentials)];
+};
+
+/* ============================================================
+ *  SLOTS
+ * ============================================================ */
+
+#define EEPROM_SLOT_MAGIC   0x42414346UL    // "BACF"
+
+struct SlotHeader {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t len;
+    uint16_t version;       // 0 = slot written before versioning (v2)
+    uint32_t crc;           // over the blob only
+};
+
+// v2.x fixed‑offset layout (see migrate_v2_to_v3)
+#define CONFIG_V2_SIZE      400
+
+#define CONFIG_RAW_MAX      (sizeof(ConfigBlob) > CONFIG_V2_SIZE ? sizeof(ConfigBlob) : CONFIG_V2_SIZE)
+
+static_assert(sizeof(SlotHeader) == EEPROM_SLOT_HEADER, "SlotHeader size");
+static_assert(EEPROM_SLOT_HEADER + CONFIG_RAW_MAX <= EEPROM_SLOT_SIZE,
+              "config blob does not fit a slot");
+static_assert(EEPROM_SLOT_BASE + EEPROM_SLOT_COUNT * EEPROM_SLOT_SIZE <= 4096,
+              "slots overlap the history spill region");
+
+/* ============================================================
+ *  SHADOW + COMMIT STATE
  * ============================================================ */
 
-static void eeprom_write16(int addr, int16_t value) {
-    EEPROM.write(addr,     (uint8_t)(value & 0xFF));
-    EEPROM.write(addr + 1, (uint8_t)((value >> 8) & 0xFF));
+static ConfigBlob shadow;                   // live blob, edited by saves
+static ConfigBlob stage;                    // blob being / last committed
+static uint8_t    raw[CONFIG_RAW_MAX];      // load + migration buffer
+
+static bool          dirty        = false;
+static bool          requested    = false;
+static unsigned long firstDirtyMs = 0;
+static unsigned long lastSaveMs   = 0;
+
+static bool     writing    = false;
+static uint16_t writePos   = 0;
+static uint8_t  writeSlot  = 0;
+static uint32_t writeSeq   = 0;
+static uint32_t writeCrc   = 0;
+
+static int8_t   lastSlot   = -1;    // -1 = nothing committed yet
+static uint32_t lastSeq    = 0;
+static uint32_t commits    = 0;
+
+static int slotAddr(uint8_t slot) {
+    return EEPROM_SLOT_BASE + (int)slot * EEPROM_SLOT_SIZE;
+}
+
+static uint32_t crc32(const uint8_t* p, uint16_t len) {
+    uint32_t c = 0xFFFFFFFFUL;
+    while (len--) {
+        c ^= *p++;
+        for (uint8_t k = 0; k < 8; k++) {
+            c = (c >> 1) ^ (0xEDB88320UL & (0UL - (c & 1)));
+        }
+    }
+    return ~c;
 }
 
-static int16_t eeprom_read16(int addr) {
-    uint8_t lo = EEPROM.read(addr);
-    uint8_t hi = EEPROM.read(addr + 1);
-    return (int16_t)((hi << 8) | lo);
+static void markDirty() {
+    unsigned long now = millis();
+    if (!dirty) firstDirtyMs = now;
+    dirty      = true;
+    lastSaveMs = now;
 }
 
+// Assign one shadow field; only a real change counts as a save
+#define SHADOW_SET(field, value)                                  \
+    do {                                                          \
+        auto v_ = (decltype(shadow.field))(value);                \
+        if (shadow.field != v_) { shadow.field = v_; markDirty(); } \
+    } while (0)
+
 /* ============================================================
- *  INIT — LOAD ALL SETTINGS YOU SAVE
+ *  BLOB ⇄ SYSTEMDATA
  * ============================================================ */
 
-void eeprom_init() {
+static void blobFromSys(ConfigBlob& b) {
+    b.exhaustSetpoint       = sys.exhaustSetpoint;
+    b.boostTimeSeconds      = sys.boostTimeSeconds;
+    b.deadbandF             = sys.deadbandF;
+    b.clampMinPercent       = sys.clampMinPercent;
+    b.clampMaxPercent       = sys.clampMaxPercent;
+    b.deadzoneFanMode       = sys.deadzoneFanMode;
+
+    b.emberGuardianMinutes  = sys.emberGuardianTimerMinutes;
+    b.flueLowThreshold      = sys.flueLowThreshold;
+    b.flueRecoveryThreshold = sys.flueRecoveryThreshold;
+
+    b.envSeasonMode         = sys.envSeasonMode;
+    b.envAutoSeason         = sys.envAutoSeasonEnabled ? 1 : 0;
+    b.envLockoutHours       = (uint8_t)(sys.envModeLockoutSec / 3600UL);
+
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        b.envStartF[s]          = *ui_getSeasonStartPtr((EnvSeason)s);
+        b.envHystF[s]           = *ui_getSeasonBufferPtr((EnvSeason)s);
+        b.envSetpointF[s]       = *ui_getSeasonSetpointPtr((EnvSeason)s);
+        b.envTankHighF[s]       = *ui_getSeasonTankHighPtr((EnvSeason)s);
+        b.envTankLowF[s]        = *ui_getSeasonTankLowPtr((EnvSeason)s);
+        b.envClampMaxPercent[s] = *ui_getSeasonClampMaxPtr((EnvSeason)s);
+    }
 
-    // === COMBUSTION SETTINGS ===
-    sys.exhaustSetpoint      = eeprom_read16(0);
-    sys.boostTimeSeconds     = eeprom_read16(2);
-    sys.deadbandF            = eeprom_read16(4);
-    sys.clampMinPercent      = eeprom_read16(6);
-    sys.clampMaxPercent      = eeprom_read16(8);
-    sys.deadzoneFanMode      = EEPROM.read(10);
-
-    // === EMBER GUARDIAN ===
-    sys.emberGuardianTimerMinutes = eeprom_read16(12);
-    sys.flueLowThreshold          = eeprom_read16(14);
-    sys.flueRecoveryThreshold     = eeprom_read16(16);
-
-    // === ENVIRONMENTAL LOGIC (ONLY FIELDS YOU ACTUALLY SAVE) ===
-    sys.envSummerStartF      = eeprom_read16(22);
-    sys.envSpringFallStartF  = eeprom_read16(24);
-    sys.envWinterStartF      = eeprom_read16(26);
-    sys.envExtremeStartF     = eeprom_read16(28);
-
-    sys.envHystSummerF       = eeprom_read16(30);
-    sys.envHystSpringFallF   = eeprom_read16(32);
-    sys.envHystWinterF       = eeprom_read16(34);
-    sys.envHystExtremeF      = eeprom_read16(36);
-
-    sys.envSetpointSummerF     = eeprom_read16(38);
-    sys.envSetpointSpringFallF = eeprom_read16(40);
-    sys.envSetpointWinterF     = eeprom_read16(42);
-    sys.envSetpointExtremeF    = eeprom_read16(44);
-
-    // === BOILER CONTROL ===
-    sys.tankLowSetpointF     = eeprom_read16(46);
-    sys.tankHighSetpointF    = eeprom_read16(48);
-    sys.controlMode          = (RunMode)EEPROM.read(50);
-
-    // === PROBE ROLES ===
-    // Default: Tank probe = physical probe 0
-    for (int i = 0; i < PROBE_ROLE_COUNT; i++) {
-        sys.probeRoleMap[i] = 0;   // everything maps to probe 0 by default
+    b.tankLowSetpointF      = sys.tankLowSetpointF;
+    b.tankHighSetpointF     = sys.tankHighSetpointF;
+    b.runMode               = (uint8_t)sys.controlMode;
+
+    memcpy(b.probeRoleMap, sys.probeRoleMap, PROBE_ROLE_COUNT);
+    memcpy(b.creds, &runtimeCreds, sizeof(RuntimeCredentials));
+}
+
+static void blobToSys(const ConfigBlob& b) {
+    sys.exhaustSetpoint           = b.exhaustSetpoint;
+    sys.boostTimeSeconds          = b.boostTimeSeconds;
+    sys.deadbandF                 = b.deadbandF;
+    sys.clampMinPercent           = b.clampMinPercent;
+    sys.clampMaxPercent           = b.clampMaxPercent;
+    sys.deadzoneFanMode           = b.deadzoneFanMode;
+
+    sys.emberGuardianTimerMinutes = b.emberGuardianMinutes;
+    sys.flueLowThreshold          = b.flueLowThreshold;
+    sys.flueRecoveryThreshold     = b.flueRecoveryThreshold;
+
+    sys.envSeasonMode             = b.envSeasonMode;
+    sys.envAutoSeasonEnabled      = (b.envAutoSeason == 1);
+    sys.envModeLockoutSec         = (uint32_t)b.envLockoutHours * 3600UL;
+
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        *ui_getSeasonStartPtr((EnvSeason)s)     = b.envStartF[s];
+        *ui_getSeasonBufferPtr((EnvSeason)s)    = b.envHystF[s];
+        *ui_getSeasonSetpointPtr((EnvSeason)s)  = b.envSetpointF[s];
+        *ui_getSeasonTankHighPtr((EnvSeason)s)  = b.envTankHighF[s];
+        *ui_getSeasonTankLowPtr((EnvSeason)s)   = b.envTankLowF[s];
+        *ui_getSeasonClampMaxPtr((EnvSeason)s)  = b.envClampMaxPercent[s];
+    }
+
+    sys.tankLowSetpointF          = b.tankLowSetpointF;
+    sys.tankHighSetpointF         = b.tankHighSetpointF;
+    sys.controlMode               = (RunMode)b.runMode;
+
+    memcpy(sys.probeRoleMap, b.probeRoleMap, PROBE_ROLE_COUNT);
+    memcpy(&runtimeCreds, b.creds, sizeof(RuntimeCredentials));
+}
+
+/* ============================================================
+ *  MIGRATIONS
+ *  ------------------------------------------------------------
+ *  Each step upgrades raw[] in place from fromVersion (fromLen
+ *  bytes) to fromVersion + 1 and returns the new length.
+ * ============================================================ */
+
+typedef uint16_t (*ConfigMigrateFn)(uint8_t* buf);
+
+struct ConfigMigration {
+    uint16_t        fromVersion;
+    uint16_t        fromLen;
+    ConfigMigrateFn fn;
+};
+
+static int16_t v2_read16(const uint8_t* buf, int addr) {
+    return (int16_t)((buf[addr + 1] << 8) | buf[addr]);
+}
+
+// v2.x: fixed offsets, little‑endian, credentials at 100
+static uint16_t migrate_v2_to_v3(uint8_t* buf) {
+    ConfigBlob b;
+    blobFromSys(b);     // defaults for fields v2 never stored
+
+    b.exhaustSetpoint       = v2_read16(buf, 0);
+    b.boostTimeSeconds      = v2_read16(buf, 2);
+    b.deadbandF             = v2_read16(buf, 4);
+    b.clampMinPercent       = v2_read16(buf, 6);
+    b.clampMaxPercent       = v2_read16(buf, 8);
+    b.deadzoneFanMode       = buf[10];
+
+    b.emberGuardianMinutes  = v2_read16(buf, 12);
+    b.flueLowThreshold      = v2_read16(buf, 14);
+    b.flueRecoveryThreshold = v2_read16(buf, 16);
+
+    b.envSeasonMode         = buf[18];
+    b.envAutoSeason         = buf[19];
+    b.envLockoutHours       = buf[20];
+
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        b.envStartF[s]      = v2_read16(buf, 22 + 2 * s);
+        b.envHystF[s]       = v2_read16(buf, 30 + 2 * s);
+        b.envSetpointF[s]   = v2_read16(buf, 38 + 2 * s);
     }
-    sys.probeRoleMap[PROBE_TANK] = 0;   // Tank = probe 0
 
+    b.tankLowSetpointF      = v2_read16(buf, 46);
+    b.tankHighSetpointF     = v2_read16(buf, 48);
+    b.runMode               = buf[50];
+
+    memcpy(b.probeRoleMap, buf + 60, PROBE_ROLE_COUNT);
+    memcpy(b.creds, buf + 100, sizeof(RuntimeCredentials));
+
+    memcpy(buf, &b, sizeof(ConfigBlob));
+    return sizeof(ConfigBlob);
+}
+
+static const ConfigMigration migrations[] = {
+    { 2, CONFIG_V2_SIZE, migrate_v2_to_v3 },
+};
+
+// Upgrade raw[] to the current version; false if no path exists
+static bool migrate(uint16_t version, uint16_t len) {
+    while (version != EEPROM_CONFIG_VERSION) {
+        const ConfigMigration* m = nullptr;
+        for (const ConfigMigration& c : migrations) {
+            if (c.fromVersion == version && c.fromLen == len) m = &c;
+        }
+        if (!m) return false;
 
+        len = m->fn(raw);
+        version++;
 
-    // === RUNTIME CREDENTIALS ===
-    for (unsigned i = 0; i < sizeof(RuntimeCredentials); i++) {
-        ((uint8_t*)&runtimeCreds)[i] = EEPROM.read(100 + i);
+        Serial.print("EEPROM: migrated config to v");
+        Serial.println(version);
     }
+    return len == sizeof(ConfigBlob);
+}
+
+/* ============================================================
+ *  LOAD
+ * ============================================================ */
 
-    /* ========================================================
-     *  SAFETY CLAMPS — PREVENT INVALID EEPROM VALUES
-     * ======================================================== */
+// Newest slot that passes its CRC into shadow; false if none
+static bool loadNewestSlot() {
+    SlotHeader h[EEPROM_SLOT_COUNT];
+    bool       tried[EEPROM_SLOT_COUNT] = { false };
+
+    for (uint8_t i = 0; i < EEPROM_SLOT_COUNT; i++) {
+        EEPROM.get(slotAddr(i), h[i]);
+        if (h[i].version == 0) h[i].version = 2;
+        tried[i] = (h[i].magic != EEPROM_SLOT_MAGIC || h[i].len > CONFIG_RAW_MAX);
+    }
+
+    // Newest first; an older slot only if the newer one is torn
+    for (;;) {
+        int8_t best = -1;
+        for (uint8_t i = 0; i < EEPROM_SLOT_COUNT; i++) {
+            if (tried[i]) continue;
+            if (best < 0 || (int32_t)(h[i].seq - h[best].seq) > 0) best = (int8_t)i;
+        }
+        if (best < 0) return false;
+        tried[best] = true;
+
+        for (uint16_t j = 0; j < h[best].len; j++) {
+            raw[j] = EEPROM.read(slotAddr(best) + EEPROM_SLOT_HEADER + j);
+        }
+        if (crc32(raw, h[best].len) != h[best].crc) continue;
+        if (!migrate(h[best].version, h[best].len)) continue;
+
+        memcpy(&shadow, raw, sizeof(ConfigBlob));
+        lastSlot = best;
+        lastSeq  = h[best].seq;
+
+        Serial.print("EEPROM: slot ");
+        Serial.print(lastSlot);
+        Serial.print(" seq ");
+        Serial.println(lastSeq);
+        return true;
+    }
+}
+
+// v2.x bytes in place at offset 0 (units that never committed a slot)
+static bool loadLegacy() {
+    bool blank = true;
+
+    for (uint16_t i = 0; i < CONFIG_V2_SIZE; i++) {
+        raw[i] = EEPROM.read(i);
+        if (i <= 50 && raw[i] != 0xFF) blank = false;
+    }
+    if (blank) return false;     // erased part, keep defaults
+
+    if (!migrate(2, CONFIG_V2_SIZE)) return false;
+
+    memcpy(&shadow, raw, sizeof(ConfigBlob));
+    Serial.println("EEPROM: loaded legacy v2 layout");
+    return true;
+}
+
+/* ============================================================
+ *  SAFETY CLAMPS — PREVENT INVALID SETTINGS
+ *  ------------------------------------------------------------
+ *  The CRC guards against corrupted bytes; these guard against
+ *  well‑formed values that are unsafe (migrated v2 data, fields
+ *  v2 saved but never loaded).
+ * ============================================================ */
+
+static void sanitize() {
 
     // BOOST TIME — critical for Guardian → BOOST behavior
     if (sys.boostTimeSeconds < 5 || sys.boostTimeSeconds > 600) {
@@ -136,6 +430,9 @@ void eeprom_init() {
     if (sys.clampMaxPercent < 0 || sys.clampMaxPercent > 100) {
         sys.clampMaxPercent = 90;
     }
+    if (sys.deadzoneFanMode > 1) {
+        sys.deadzoneFanMode = 0;
+    }
 
     // Guardian thresholds sanity
     if (sys.emberGuardianTimerMinutes < 1 || sys.emberGuardianTimerMinutes > 120) {
@@ -147,6 +444,66 @@ void eeprom_init() {
     if (sys.flueRecoveryThreshold < 50 || sys.flueRecoveryThreshold > 500) {
         sys.flueRecoveryThreshold = 180;
     }
+
+    // Season selection sanity
+    if (sys.envSeasonMode > 2) {
+        sys.envSeasonMode = 0;
+    }
+    if (sys.envModeLockoutSec > 99UL * 3600UL) {
+        sys.envModeLockoutSec = 0;
+    }
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        uint8_t* clamp = ui_getSeasonClampMaxPtr((EnvSeason)s);
+        if (*clamp > 100) *clamp = 100;
+    }
+
+    // Boiler control sanity
+    if (sys.controlMode != RUNMODE_CONTINUOUS && sys.controlMode != RUNMODE_AUTO_TANK) {
+        sys.controlMode = RUNMODE_CONTINUOUS;
+    }
+
+    // Probe roles must name a physical probe
+    for (int i = 0; i < PROBE_ROLE_COUNT; i++) {
+        if (sys.probeRoleMap[i] >= MAX_WATER_PROBES) sys.probeRoleMap[i] = 0;
+    }
+    // Credential strings always terminated (erased bytes are 0xFF)
+    runtimeCreds.ssid[sizeof(runtimeCreds.ssid) - 1]             = '\0';
+    runtimeCreds.pass[sizeof(runtimeCreds.pass) - 1]             = '\0';
+    runtimeCreds.mqttServer[sizeof(runtimeCreds.mqttServer) - 1] = '\0';
+    runtimeCreds.mqttUser[sizeof(runtimeCreds.mqttUser) - 1]     = '\0';
+    runtimeCreds.mqttPass[sizeof(runtimeCreds.mqttPass) - 1]     = '\0';
+    runtimeCreds.otaPass[sizeof(runtimeCreds.otaPass) - 1]       = '\0';
+}
+
+/* ============================================================
+ *  INIT — ONE BULK READ, THEN SYSTEMDATA
+ * ============================================================ */
+
+void eeprom_init() {
+
+    writing   = false;
+    dirty     = false;
+    requested = false;
+    lastSlot  = -1;
+    lastSeq   = 0;
+
+    bool loaded = loadNewestSlot() || loadLegacy();
+
+    if (loaded) {
+        blobToSys(shadow);
+    } else {
+        Serial.println("EEPROM: no stored config, using defaults");
+    }
+
+    sanitize();
+
+    // Shadow mirrors what actually runs; a first slot (migration or
+    // clamped values) is written by the normal deferred commit
+    memcpy(&stage, &shadow, sizeof(ConfigBlob));
+    blobFromSys(shadow);
+    if (!loaded || lastSlot < 0 || memcmp(&shadow, &stage, sizeof(ConfigBlob)) != 0) {
+        markDirty();
+    }
 }
 
 /* ============================================================
@@ -154,27 +511,27 @@ void eeprom_init() {
  * ============================================================ */
 
 void eeprom_saveSetpoint(int v) {
-    eeprom_write16(0, (int16_t)v);
+    SHADOW_SET(exhaustSetpoint, v);
 }
 
 void eeprom_saveBoostTime(int v) {
-    eeprom_write16(2, (int16_t)v);
+    SHADOW_SET(boostTimeSeconds, v);
 }
 
 void eeprom_saveDeadband(int v) {
-    eeprom_write16(4, (int16_t)v);
+    SHADOW_SET(deadbandF, v);
 }
 
 void eeprom_saveClampMin(int v) {
-    eeprom_write16(6, (int16_t)v);
+    SHADOW_SET(clampMinPercent, v);
 }
 
 void eeprom_saveClampMax(int v) {
-    eeprom_write16(8, (int16_t)v);
+    SHADOW_SET(clampMaxPercent, v);
 }
 
 void eeprom_saveDeadzone(int v) {
-    EEPROM.write(10, (uint8_t)v);
+    SHADOW_SET(deadzoneFanMode, v);
 }
 
 /* ============================================================
@@ -182,15 +539,15 @@ void eeprom_saveDeadzone(int v) {
  * ============================================================ */
 
 void eeprom_saveEmberGuardianMinutes(int v) {
-    eeprom_write16(12, (int16_t)v);
+    SHADOW_SET(emberGuardianMinutes, v);
 }
 
 void eeprom_saveFlueLow(int v) {
-    eeprom_write16(14, (int16_t)v);
+    SHADOW_SET(flueLowThreshold, v);
 }
 
 void eeprom_saveFlueRecovery(int v) {
-    eeprom_write16(16, (int16_t)v);
+    SHADOW_SET(flueRecoveryThreshold, v);
 }
 
 /* ============================================================
@@ -199,7 +556,7 @@ void eeprom_saveFlueRecovery(int v) {
 
 void eeprom_saveProbeRoles() {
     for (int i = 0; i < PROBE_ROLE_COUNT; i++) {
-        EEPROM.write(60 + i, sys.probeRoleMap[i]);
+        SHADOW_SET(probeRoleMap[i], sys.probeRoleMap[i]);
     }
 }
 
@@ -208,36 +565,46 @@ void eeprom_saveProbeRoles() {
  * ============================================================ */
 
 void eeprom_saveEnvSeasonMode(uint8_t mode) {
-    EEPROM.write(18, mode);
+    SHADOW_SET(envSeasonMode, mode);
 }
 
 void eeprom_saveEnvAutoSeason(bool en) {
-    EEPROM.write(19, en ? 1 : 0);
+    SHADOW_SET(envAutoSeason, en ? 1 : 0);
 }
 
 void eeprom_saveEnvLockoutHours(uint8_t hours) {
-    EEPROM.write(20, hours);
+    SHADOW_SET(envLockoutHours, hours);
 }
 
 void eeprom_saveEnvSeasonStarts() {
-    eeprom_write16(22, sys.envSummerStartF);
-    eeprom_write16(24, sys.envSpringFallStartF);
-    eeprom_write16(26, sys.envWinterStartF);
-    eeprom_write16(28, sys.envExtremeStartF);
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        SHADOW_SET(envStartF[s], *ui_getSeasonStartPtr((EnvSeason)s));
+    }
 }
 
 void eeprom_saveEnvSeasonHyst() {
-    eeprom_write16(30, sys.envHystSummerF);
-    eeprom_write16(32, sys.envHystSpringFallF);
-    eeprom_write16(34, sys.envHystWinterF);
-    eeprom_write16(36, sys.envHystExtremeF);
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        SHADOW_SET(envHystF[s], *ui_getSeasonBufferPtr((EnvSeason)s));
+    }
 }
 
 void eeprom_saveEnvSeasonSetpoints() {
-    eeprom_write16(38, sys.envSetpointSummerF);
-    eeprom_write16(40, sys.envSetpointSpringFallF);
-    eeprom_write16(42, sys.envSetpointWinterF);
-    eeprom_write16(44, sys.envSetpointExtremeF);
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        SHADOW_SET(envSetpointF[s], *ui_getSeasonSetpointPtr((EnvSeason)s));
+    }
+}
+
+void eeprom_saveEnvSeasonTankValues() {
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        SHADOW_SET(envTankHighF[s], *ui_getSeasonTankHighPtr((EnvSeason)s));
+        SHADOW_SET(envTankLowF[s],  *ui_getSeasonTankLowPtr((EnvSeason)s));
+    }
+}
+
+void eeprom_saveEnvSeasonClampValues() {
+    for (uint8_t s = 0; s < ENV_SEASONS; s++) {
+        SHADOW_SET(envClampMaxPercent[s], *ui_getSeasonClampMaxPtr((EnvSeason)s));
+    }
 }
 
 /* ============================================================
@@ -245,15 +612,15 @@ void eeprom_saveEnvSeasonSetpoints() {
  * ============================================================ */
 
 void eeprom_saveTankLow(int v) {
-    eeprom_write16(46, (int16_t)v);
+    SHADOW_SET(tankLowSetpointF, v);
 }
 
 void eeprom_saveTankHigh(int v) {
-    eeprom_write16(48, (int16_t)v);
+    SHADOW_SET(tankHighSetpointF, v);
 }
 
 void eeprom_saveRunMode(uint8_t mode) {
-    EEPROM.write(50, mode);
+    SHADOW_SET(runMode, mode);
 }
 
 /* ============================================================
@@ -261,8 +628,92 @@ void eeprom_saveRunMode(uint8_t mode) {
  * ============================================================ */
 
 void eeprom_saveRuntimeCreds() {
-    for (unsigned i = 0; i < sizeof(RuntimeCredentials); i++) {
-        EEPROM.write(100 + i, ((uint8_t*)&runtimeCreds)[i]);
+    if (memcmp(shadow.creds, &runtimeCreds, sizeof(RuntimeCredentials)) == 0) return;
+    memcpy(shadow.creds, &runtimeCreds, sizeof(RuntimeCredentials));
+    markDirty();
+}
+
+/* ============================================================
+ *  DEFERRED COMMIT
+ * ============================================================ */
+
+// Snapshot the shadow into the next slot's staging copy
+static void beginCommit() {
+    dirty     = false;
+    requested = false;
+
+    // Edits that cancel out (slider dragged back) cost nothing
+    if (lastSlot >= 0 && memcmp(&shadow, &stage, sizeof(ConfigBlob)) == 0) return;
+
+    memcpy(&stage, &shadow, sizeof(ConfigBlob));
+    writeCrc  = crc32((const uint8_t*)&stage, sizeof(ConfigBlob));
+    writeSlot = (uint8_t)((lastSlot + 1) % EEPROM_SLOT_COUNT);
+    writeSeq  = lastSeq + 1;
+    writePos  = 0;
+    writing   = true;
+}
+
+// Write up to maxBytes of the blob; header last once complete
+static void stepCommit(uint16_t maxBytes) {
+    const uint8_t* src  = (const uint8_t*)&stage;
+    int            base = slotAddr(writeSlot) + EEPROM_SLOT_HEADER;
+
+    while (writePos < sizeof(ConfigBlob) && maxBytes--) {
+        EEPROM.update(base + writePos, src[writePos]);
+        writePos++;
+    }
+    if (writePos < sizeof(ConfigBlob)) return;
+
+    SlotHeader h;
+    h.magic   = EEPROM_SLOT_MAGIC;
+    h.seq     = writeSeq;
+    h.len     = sizeof(ConfigBlob);
+    h.version = EEPROM_CONFIG_VERSION;
+    h.crc     = writeCrc;
+    EEPROM.put(slotAddr(writeSlot), h);
+
+    lastSlot = (int8_t)writeSlot;
+    lastSeq  = writeSeq;
+    writing  = false;
+    commits++;
+
+    Serial.print("EEPROM: committed slot ");
+    Serial.print(writeSlot);
+    Serial.print(" seq ");
+    Serial.println(writeSeq);
+}
+
+void eeprom_poll(unsigned long now) {
+    if (writing) {
+        stepCommit(EEPROM_COMMIT_CHUNK);
+        return;
+    }
+
+    if (!dirty) return;
+
+    if (requested ||
+        now - lastSaveMs   >= EEPROM_QUIET_MS ||
+        now - firstDirtyMs >= EEPROM_MAX_DEFER_MS) {
+        beginCommit();
     }
 }
 
+void eeprom_requestCommit() {
+    if (dirty) requested = true;
+}
+
+void eeprom_commit() {
+    if (writing) stepCommit(sizeof(ConfigBlob));
+    if (!dirty)  return;
+
+    beginCommit();
+    if (writing) stepCommit(sizeof(ConfigBlob));
+}
+
+bool eeprom_pending() {
+    return dirty || writing;
+}
+
+uint32_t eeprom_commitCount() {
+    return commits;
+}
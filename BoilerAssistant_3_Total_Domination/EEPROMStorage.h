@@ -20,13 +20,21 @@
  *
  *    All persistent values follow the Total Domination Architecture:
  *      - SystemData is the single source of truth
- *      - EEPROM layout is fixed and version-stable
- *      - Multibyte values use explicit little-endian encoding
+ *      - EEPROM layout is versioned; older layouts are migrated
+ *      - Multibyte values are little-endian
+ *
+ *    Settings are stored as one packed, versioned ConfigBlob
+ *    (magic, version, length, CRC32 header). Saves are
+ *    write‑coalesced: they update a RAM shadow, and eeprom_poll()
+ *    commits the whole blob later into one of EEPROM_SLOT_COUNT
+ *    rotating slots.
  *
  *  Architectural Notes:
  *      - This header exposes only the public API; implementation
  *        resides in EEPROMStorage.cpp.
  *      - No UI or control logic belongs here.
+ *      - Anything that resets the MCU must call eeprom_commit()
+ *        first, or the last few seconds of edits are lost.
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -38,11 +46,44 @@
 
 #include <Arduino.h>
 
+/* ============================================================
+ *  CONFIGURATION
+ * ============================================================ */
+#define EEPROM_CONFIG_VERSION      3        // ConfigBlob layout (2 = v2.x offsets)
+
+#define EEPROM_SLOT_BASE           512      // 512..4095, below the history spill
+#define EEPROM_SLOT_SIZE           512
+#define EEPROM_SLOT_COUNT          7
+#define EEPROM_SLOT_HEADER         16
+
+#define EEPROM_QUIET_MS            5000UL   // commit after this long without saves
+#define EEPROM_MAX_DEFER_MS        60000UL  // ...or this long after the first one
+#define EEPROM_COMMIT_CHUNK        16       // image bytes written per poll
+
 /* ============================================================
  *  INIT
  * ============================================================ */
 void eeprom_init();
 
+/* ============================================================
+ *  COMMIT
+ * ============================================================ */
+
+// Advance a pending commit (call periodically from a background task)
+void eeprom_poll(unsigned long now);
+
+// Commit on the next poll without waiting for the quiet period
+void eeprom_requestCommit();
+
+// Blocking commit of everything pending (before a reset)
+void eeprom_commit();
+
+// Unsaved or half‑written changes exist
+bool eeprom_pending();
+
+// Completed slot commits since boot
+uint32_t eeprom_commitCount();
+
 /* ============================================================
  *  COMBUSTION SETTINGS
  * ============================================================ */
@@ -0,0 +1,226 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – BME280 Driver (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: EnvSensor.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Forced‑mode BME280 access with one 8‑byte burst read per
+ *    update. Replaces the Adafruit_BME280 readTemperature() /
+ *    readHumidity() / readPressure() sequence, where each call
+ *    re‑read the temperature registers to refresh t_fine.
+ *
+ *  Architectural Notes:
+ *      - Compensation: BME280 datasheet rev 1.6, section 4.2.3
+ *        (32‑bit temperature/humidity, 64‑bit pressure)
+ *      - A read before the conversion can have finished returns
+ *        false instead of blocking on the status register
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "EnvSensor.h"
+
+/* ============================================================
+ *  REGISTERS
+ * ============================================================ */
+#define BME_REG_CALIB_TP   0x88   // 0x88..0xA1 (T1..P9, H1 at 0xA1)
+#define BME_REG_CHIP_ID    0xD0
+#define BME_REG_RESET      0xE0
+#define BME_REG_CALIB_H    0xE1   // 0xE1..0xE7 (H2..H6)
+#define BME_REG_CTRL_HUM   0xF2
+#define BME_REG_STATUS     0xF3
+#define BME_REG_CTRL_MEAS  0xF4
+#define BME_REG_CONFIG     0xF5
+#define BME_REG_DATA       0xF7   // 0xF7..0xFE
+
+#define BME_CHIP_ID        0x60
+#define BME_RESET_CMD      0xB6
+#define BME_MODE_FORCED    0x01
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+struct BmeCalib {
+    uint16_t T1; int16_t T2, T3;
+    uint16_t P1; int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+    uint8_t  H1; int16_t H2; uint8_t H3; int16_t H4, H5; int8_t H6;
+};
+
+static TwoWire*      bus        = nullptr;
+static uint8_t       devAddr    = 0x76;
+static BmeCalib      cal;
+static uint8_t       ctrlMeas   = 0;
+static uint16_t      measMs     = 10;
+static unsigned long triggerMs  = 0;
+
+/* ============================================================
+ *  BUS HELPERS
+ * ============================================================ */
+static bool writeReg(uint8_t reg, uint8_t val) {
+    bus->beginTransmission(devAddr);
+    bus->write(reg);
+    bus->write(val);
+    return bus->endTransmission() == 0;
+}
+
+static bool readRegs(uint8_t reg, uint8_t* buf, uint8_t len) {
+    bus->beginTransmission(devAddr);
+    bus->write(reg);
+    if (bus->endTransmission(false) != 0) return false;
+
+    if (bus->requestFrom(devAddr, len) != len) return false;
+    for (uint8_t i = 0; i < len; i++) buf[i] = (uint8_t)bus->read();
+    return true;
+}
+
+static uint16_t u16le(const uint8_t* b) { return (uint16_t)(b[0] | (b[1] << 8)); }
+static int16_t  s16le(const uint8_t* b) { return (int16_t)u16le(b); }
+
+// Oversampling code → sample count (0 = skipped)
+static uint8_t osrsCount(uint8_t code) {
+    return code ? (uint8_t)(1 << (code - 1)) : 0;
+}
+
+/* ============================================================
+ *  COMPENSATION (datasheet integer formulas)
+ * ============================================================ */
+
+// Returns °C × 100; writes t_fine for the other two steps
+static int32_t compensateT(int32_t adcT, int32_t* tFine) {
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)cal.T1 << 1))) * (int32_t)cal.T2) >> 11;
+    int32_t var2 = (((((adcT >> 4) - (int32_t)cal.T1) *
+                      ((adcT >> 4) - (int32_t)cal.T1)) >> 12) * (int32_t)cal.T3) >> 14;
+    *tFine = var1 + var2;
+    return (*tFine * 5 + 128) >> 8;
+}
+
+// Returns Pa in Q24.8
+static uint32_t compensateP(int32_t adcP, int32_t tFine) {
+    int64_t var1 = (int64_t)tFine - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)cal.P6;
+    var2 = var2 + ((var1 * (int64_t)cal.P5) << 17);
+    var2 = var2 + ((int64_t)cal.P4 << 35);
+    var1 = ((var1 * var1 * (int64_t)cal.P3) >> 8) + ((var1 * (int64_t)cal.P2) << 12);
+    var1 = ((((int64_t)1 << 47) + var1) * (int64_t)cal.P1) >> 33;
+    if (var1 == 0) return 0;
+
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = ((int64_t)cal.P9 * (p >> 13) * (p >> 13)) >> 25;
+    var2 = ((int64_t)cal.P8 * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + ((int64_t)cal.P7 << 4);
+    return (uint32_t)p;
+}
+
+// Returns %RH in Q22.10
+static uint32_t compensateH(int32_t adcH, int32_t tFine) {
+    int32_t v = tFine - 76800;
+    v = (((((adcH << 14) - ((int32_t)cal.H4 << 20) - ((int32_t)cal.H5 * v)) + 16384) >> 15) *
+         (((((((v * (int32_t)cal.H6) >> 10) *
+              (((v * (int32_t)cal.H3) >> 11) + 32768)) >> 10) + 2097152) *
+           (int32_t)cal.H2 + 8192) >> 14));
+    v = v - (((((v >> 15) * (v >> 15)) >> 7) * (int32_t)cal.H1) >> 4);
+    if (v < 0)         v = 0;
+    if (v > 419430400) v = 419430400;
+    return (uint32_t)(v >> 12);
+}
+
+/* ============================================================
+ *  INIT
+ * ============================================================ */
+static bool readCalibration() {
+    uint8_t b[26];
+    if (!readRegs(BME_REG_CALIB_TP, b, 26)) return false;
+
+    cal.T1 = u16le(b + 0);  cal.T2 = s16le(b + 2);  cal.T3 = s16le(b + 4);
+    cal.P1 = u16le(b + 6);  cal.P2 = s16le(b + 8);  cal.P3 = s16le(b + 10);
+    cal.P4 = s16le(b + 12); cal.P5 = s16le(b + 14); cal.P6 = s16le(b + 16);
+    cal.P7 = s16le(b + 18); cal.P8 = s16le(b + 20); cal.P9 = s16le(b + 22);
+    cal.H1 = b[25];
+
+    uint8_t h[7];
+    if (!readRegs(BME_REG_CALIB_H, h, 7)) return false;
+
+    cal.H2 = s16le(h + 0);
+    cal.H3 = h[2];
+    cal.H4 = (int16_t)(((int8_t)h[3] << 4) | (h[4] & 0x0F));
+    cal.H5 = (int16_t)(((int8_t)h[5] << 4) | (h[4] >> 4));
+    cal.H6 = (int8_t)h[6];
+    return true;
+}
+
+bool envsensor_begin(uint8_t addr, TwoWire& wire) {
+    bus     = &wire;
+    devAddr = addr;
+
+    uint8_t id = 0;
+    if (!readRegs(BME_REG_CHIP_ID, &id, 1) || id != BME_CHIP_ID) return false;
+
+    // Soft reset, then wait for the NVM copy (im_update) to finish
+    writeReg(BME_REG_RESET, BME_RESET_CMD);
+    delay(2);
+    for (uint8_t i = 0; i < 10; i++) {
+        uint8_t st = 0x01;
+        if (readRegs(BME_REG_STATUS, &st, 1) && !(st & 0x01)) break;
+        delay(1);
+    }
+
+    if (!readCalibration()) return false;
+
+    // ctrl_hum only takes effect after a ctrl_meas write
+    ctrlMeas = (uint8_t)((ENV_SENSOR_OSRS_T << 5) | (ENV_SENSOR_OSRS_P << 2) | BME_MODE_FORCED);
+
+    if (!writeReg(BME_REG_CTRL_HUM, ENV_SENSOR_OSRS_H))     return false;
+    if (!writeReg(BME_REG_CONFIG,   ENV_SENSOR_IIR << 2))   return false;
+
+    // Datasheet max measurement time (appendix B), rounded up
+    uint8_t osT = osrsCount(ENV_SENSOR_OSRS_T);
+    uint8_t osP = osrsCount(ENV_SENSOR_OSRS_P);
+    uint8_t osH = osrsCount(ENV_SENSOR_OSRS_H);
+    uint32_t us = 1250 + 2300UL * osT
+                + (osP ? 2300UL * osP + 575 : 0)
+                + (osH ? 2300UL * osH + 575 : 0);
+    measMs = (uint16_t)((us + 999) / 1000);
+
+    if (!writeReg(BME_REG_CTRL_MEAS, ctrlMeas)) return false;
+    triggerMs = millis();
+    return true;
+}
+
+/* ============================================================
+ *  READ
+ * ============================================================ */
+bool envsensor_read(float* tempC, float* humidity, float* pressurePa) {
+    if (!bus) return false;
+    if (millis() - triggerMs < measMs) return false;
+
+    uint8_t d[8];
+    if (!readRegs(BME_REG_DATA, d, 8)) return false;
+
+    // Start the next conversion right away; it completes long
+    // before the next env tick.
+    if (writeReg(BME_REG_CTRL_MEAS, ctrlMeas)) triggerMs = millis();
+
+    int32_t adcP = ((int32_t)d[0] << 12) | ((int32_t)d[1] << 4) | (d[2] >> 4);
+    int32_t adcT = ((int32_t)d[3] << 12) | ((int32_t)d[4] << 4) | (d[5] >> 4);
+    int32_t adcH = ((int32_t)d[6] << 8)  |  d[7];
+
+    // 0x80000 = temperature skipped / no conversion since reset
+    if (adcT == 0x80000) return false;
+
+    int32_t tFine;
+    *tempC = compensateT(adcT, &tFine) / 100.0f;
+
+    *pressurePa = (ENV_SENSOR_OSRS_P && adcP != 0x80000)
+                  ? compensateP(adcP, tFine) / 256.0f : NAN;
+
+    *humidity   = (ENV_SENSOR_OSRS_H && adcH != 0x8000)
+                  ? compensateH(adcH, tFine) / 1024.0f : NAN;
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – BME280 Driver API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: EnvSensor.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Minimal forced‑mode BME280 driver for the outdoor sensor.
+ *    One update is two short I2C transactions on the shared bus:
+ *
+ *      burst read 0xF7..0xFE (press/temp/hum, 8 bytes)
+ *      write ctrl_meas      (trigger the next forced conversion)
+ *
+ *    Compensation runs once per update using the datasheet
+ *    integer formulas; t_fine from the temperature step feeds the
+ *    pressure and humidity steps directly.
+ *
+ *  Architectural Notes:
+ *      - Calibration is read once in envsensor_begin()
+ *      - The sensor sleeps between forced conversions
+ *      - No SystemData writes; Sensors.cpp owns the mapping
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef ENV_SENSOR_H
+#define ENV_SENSOR_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/* ============================================================
+ *  MEASUREMENT PROFILE
+ *  ------------------------------------------------------------
+ *  Oversampling codes: 0 = skip, 1 = ×1, 2 = ×2, 3 = ×4,
+ *                      4 = ×8, 5 = ×16
+ *  IIR filter codes:   0 = off, 1 = 2, 2 = 4, 3 = 8, 4 = 16
+ *
+ *  Default is the datasheet "weather monitoring" profile
+ *  (×1 / ×1 / ×1, filter off) — the outdoor air changes far
+ *  slower than the 3 s update period.
+ * ============================================================ */
+#ifndef ENV_SENSOR_OSRS_T
+#define ENV_SENSOR_OSRS_T 1
+#endif
+
+#ifndef ENV_SENSOR_OSRS_P
+#define ENV_SENSOR_OSRS_P 1
+#endif
+
+#ifndef ENV_SENSOR_OSRS_H
+#define ENV_SENSOR_OSRS_H 1
+#endif
+
+#ifndef ENV_SENSOR_IIR
+#define ENV_SENSOR_IIR 0
+#endif
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Probe chip ID, soft reset, load calibration, write the profile
+// and start the first forced conversion. Returns false if absent.
+bool envsensor_begin(uint8_t addr, TwoWire& bus = Wire);
+
+// Burst‑read the last conversion, compensate, start the next one.
+// Returns false while a conversion is still in progress or on a
+// bus error; outputs are untouched in that case.
+bool envsensor_read(float* tempC, float* humidity, float* pressurePa);
+
+#endif
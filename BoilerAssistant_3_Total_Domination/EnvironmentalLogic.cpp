@@ -84,6 +84,10 @@ static void applySeasonalOverrides(EnvSeason s)
         case ENV_SEASON_EXTREME:
             sys.exhaustSetpoint = sys.envSetpointExtremeF;
             break;
+
+        case ENV_SEASON_NONE:       // not yet evaluated: keep current values
+        default:
+            break;
     }
 
     /* Tank High / Low / ClampMax */
@@ -111,6 +115,10 @@ static void applySeasonalOverrides(EnvSeason s)
             sys.tankLowSetpointF  = sys.envTankLowExtremeF;
             sys.clampMaxPercent   = sys.envClampMaxExtremePercent;
             break;
+
+        case ENV_SEASON_NONE:
+        default:
+            break;
     }
 }
 
@@ -139,3 +147,12 @@ void environmentalLogic_update()
     // Update active season for UI
     sys.envActiveSeason = s;
 }
+
+/* ============================================================
+ *  PUBLIC: PERIODIC UPDATE (header API, EnvironmentalLogic.h)
+ * ============================================================ */
+void env_logic_update(unsigned long nowMs)
+{
+    (void)nowMs;   // reserved for time‑based lockouts
+    environmentalLogic_update();
+}
@@ -0,0 +1,136 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Exhaust Filter Module (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: ExhaustFilter.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Implements the single exhaust filter stage: an optional
+ *    median‑of‑N spike rejector followed by a time‑constant based
+ *    first‑order low‑pass. Replaces the three independent EMA
+ *    filters that used to live in the main loop, the keypad
+ *    branch, and sensors_readAll().
+ *
+ *  Architectural Notes:
+ *      - Called once per fresh MAX31855 sample (every 250 ms)
+ *      - dt is measured between samples and clamped to 4× the
+ *        nominal period so a stalled loop cannot overshoot
+ *      - All math in single precision (RA4M1 FPU)
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "ExhaustFilter.h"
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static const unsigned long NOMINAL_SAMPLE_MS = 250UL;
+
+static uint16_t tauMs     = EXHAUST_FILTER_TAU_MS;
+static uint8_t  medianLen = EXHAUST_FILTER_MEDIAN;
+
+static float    medianBuf[EXHAUST_FILTER_MEDIAN_MAX];
+static uint8_t  medianFill = 0;
+static uint8_t  medianHead = 0;
+
+static float         output       = NAN;
+static unsigned long lastSampleMs = 0;
+
+/* ============================================================
+ *  HELPERS
+ * ============================================================ */
+static uint8_t sanitizeMedian(uint8_t n) {
+    if (n < 3) return 0;        // 0 or 1: no median stage
+    if (n >= 5) return 5;
+    return 3;
+}
+
+static float medianStage(float rawF) {
+    if (medianLen == 0) return rawF;
+
+    medianBuf[medianHead] = rawF;
+    medianHead = (medianHead + 1) % medianLen;
+    if (medianFill < medianLen) medianFill++;
+
+    // Insertion sort of at most 5 values
+    float s[EXHAUST_FILTER_MEDIAN_MAX];
+    for (uint8_t i = 0; i < medianFill; i++) {
+        float v = medianBuf[i];
+        int8_t j = (int8_t)i - 1;
+        while (j >= 0 && s[j] > v) {
+            s[j + 1] = s[j];
+            j--;
+        }
+        s[j + 1] = v;
+    }
+
+    return s[medianFill / 2];
+}
+
+/* ============================================================
+ *  CONFIGURATION
+ * ============================================================ */
+void exhfilter_reset() {
+    medianFill   = 0;
+    medianHead   = 0;
+    output       = NAN;
+    lastSampleMs = 0;
+}
+
+void exhfilter_init() {
+    tauMs     = EXHAUST_FILTER_TAU_MS;
+    medianLen = sanitizeMedian(EXHAUST_FILTER_MEDIAN);
+    exhfilter_reset();
+}
+
+void exhfilter_configure(uint16_t newTauMs, uint8_t newMedianLen) {
+    tauMs     = newTauMs;
+    medianLen = sanitizeMedian(newMedianLen);
+    exhfilter_reset();
+}
+
+uint16_t exhfilter_tauMs() {
+    return tauMs;
+}
+
+uint8_t exhfilter_medianLen() {
+    return medianLen;
+}
+
+/* ============================================================
+ *  FILTER
+ * ============================================================ */
+float exhfilter_push(float rawF, unsigned long sampleMs) {
+    if (isnan(rawF)) return output;
+
+    float x = medianStage(rawF);
+
+    if (isnan(output)) {
+        output       = x;
+        lastSampleMs = sampleMs;
+        return output;
+    }
+
+    unsigned long dt = sampleMs - lastSampleMs;
+    lastSampleMs = sampleMs;
+
+    if (dt == 0) dt = 1;
+    if (dt > 4 * NOMINAL_SAMPLE_MS) dt = 4 * NOMINAL_SAMPLE_MS;
+
+    float alpha = (tauMs == 0)
+                  ? 1.0f
+                  : (float)dt / ((float)tauMs + (float)dt);
+
+    output += alpha * (x - output);
+    return output;
+}
+
+float exhfilter_value() {
+    return output;
+}
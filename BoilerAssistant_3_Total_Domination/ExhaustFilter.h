@@ -0,0 +1,82 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Exhaust Filter API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: ExhaustFilter.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Single exhaust filtering stage for the MAX31855 flue probe.
+ *    The filter runs exactly once per fresh thermocouple sample,
+ *    so its response no longer depends on loop speed, WiFi load,
+ *    or how many keys were pressed.
+ *
+ *    Pipeline (per fresh sample):
+ *      raw °F → [optional median‑of‑N spike rejection]
+ *             → first‑order low‑pass with time constant τ
+ *
+ *    The low‑pass coefficient is derived from the real interval
+ *    between samples:  α = dt / (τ + dt)
+ *    With the default τ = 1000 ms and 250 ms samples, α = 0.2,
+ *    matching the legacy 0.8/0.2 smoothing at its nominal rate.
+ *    That holds with the median stage off (the default); enabling
+ *    it trades one or two samples of extra lag for spike rejection.
+ *
+ *  Architectural Notes:
+ *      - Pure logic: no hardware access, no SystemData writes
+ *      - Sensors.cpp owns the single filter instance
+ *      - NaN samples are ignored (the last output is held)
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef EXHAUST_FILTER_H
+#define EXHAUST_FILTER_H
+
+#include <Arduino.h>
+
+/* ============================================================
+ *  DEFAULTS
+ * ============================================================ */
+
+// Low‑pass time constant (ms)
+#ifndef EXHAUST_FILTER_TAU_MS
+#define EXHAUST_FILTER_TAU_MS 1000
+#endif
+
+// Median pre‑stage length: 1 (or 0) = off, 3 or 5. Off by
+// default; 3 rejects single‑sample spikes but adds one sample
+// (250 ms) of lag, 5 adds two
+#ifndef EXHAUST_FILTER_MEDIAN
+#define EXHAUST_FILTER_MEDIAN 1
+#endif
+
+#define EXHAUST_FILTER_MEDIAN_MAX 5
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Load compile‑time defaults and clear history
+void exhfilter_init();
+
+// Change time constant / median length at runtime (clears history)
+void exhfilter_configure(uint16_t tauMs, uint8_t medianLen);
+
+uint16_t exhfilter_tauMs();
+uint8_t  exhfilter_medianLen();
+
+// Clear history; the next sample seeds the output directly
+void exhfilter_reset();
+
+// Push one fresh sample taken at sampleMs; returns the filtered value
+float exhfilter_push(float rawF, unsigned long sampleMs);
+
+// Last filtered value (NaN until the first valid sample)
+float exhfilter_value();
+
+#endif
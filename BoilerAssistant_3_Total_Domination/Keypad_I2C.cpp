@@ -16,6 +16,9 @@
  *
  *    Features:
  *      • 4×4 matrix scan (rows driven low, columns read)
+ *      • Idle mode: all rows parked low, one expander read per
+ *        call, or (KEYPAD_USE_INT = 1, D2 wired) scan only after
+ *        the expander's INT line reports an edge
  *      • Debounce filtering (40 ms stable requirement)
  *      • Stable key reporting (no repeats until release)
  *      • Zero blocking delays (only µs‑level settling)
@@ -23,7 +26,12 @@
  *
  *    Notes:
  *      - scanMatrix() performs raw hardware scanning
- *      - keypad_read() applies debounce + stable reporting
+ *      - keypad_read() is a timestamp‑based debounce state machine
+ *      - KEYPAD_USE_INT defaults to 0: no shipped unit has the
+ *        PCF8574 INT wired to PIN_KEYPAD_INT (D2)
+ *      - INT mode still reads the expander every
+ *        KEYPAD_INT_FALLBACK_MS, so a missing wire means sluggish
+ *        keys rather than a dead keypad
  *      - No dynamic allocation, no Strings, no blocking calls
  *      - All timing uses millis() and remains non‑blocking
  *
@@ -33,9 +41,15 @@
  */
 
 #include "Keypad_I2C.h"
+#include "Pinout.h"
 
 #define KEYPAD_ADDR 0x20
 
+// Rows P0..P3 driven low, columns P4..P7 released (quasi‑inputs)
+#define KEYPAD_PARK_MASK 0xF0
+
+#define KEYPAD_DEBOUNCE_MS 40
+
 /* ============================================================
  *  INTERNAL STATE
  * ============================================================ */
@@ -49,9 +63,47 @@ static const char keymap[4][4] = {
     {'*','0','#','D'}
 };
 
-static char lastStableKey     = 0;
-static char lastReportedKey   = 0;
-static unsigned long lastChangeTime = 0;
+enum KeypadState : uint8_t {
+    KP_IDLE,              // rows parked, waiting for INT edge
+    KP_PRESS_DEBOUNCE,    // candidate key must stay stable
+    KP_HELD,              // key reported, waiting for release
+    KP_RELEASE_DEBOUNCE   // no key seen, must stay released
+};
+
+static KeypadState   kpState       = KP_IDLE;
+static char          kpCandidate   = 0;
+static unsigned long kpChangeMs    = 0;
+
+#if KEYPAD_USE_INT
+static volatile bool kpEdge = false;
+static unsigned long kpFallbackMs = 0;
+
+static void keypadIsr() {
+    kpEdge = true;
+}
+#endif
+
+/* ============================================================
+ *  IDLE PARKING
+ * ============================================================
+ *  Drives every row low at once so any key pulls its column
+ *  low. Reading the port back clears the PCF8574 INT latch.
+ *  Returns true if a column is already low (key down).
+ * ============================================================ */
+
+static bool parkRows() {
+    if (!kb) return false;
+
+    kb->beginTransmission(KEYPAD_ADDR);
+    kb->write(KEYPAD_PARK_MASK);
+    kb->endTransmission();
+
+    kb->requestFrom(KEYPAD_ADDR, 1);
+    if (!kb->available()) return false;
+
+    uint8_t colData = kb->read();
+    return (colData & KEYPAD_PARK_MASK) != KEYPAD_PARK_MASK;
+}
 
 /* ============================================================
  *  INITIALIZATION
@@ -59,6 +111,19 @@ static unsigned long lastChangeTime = 0;
 
 void keypad_init(TwoWire &bus) {
     kb = &bus;
+
+#if KEYPAD_USE_INT
+    // PCF8574 INT is open‑drain, active low
+    pinMode(PIN_KEYPAD_INT, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(PIN_KEYPAD_INT), keypadIsr, FALLING);
+#endif
+
+    kpState = KP_IDLE;
+    if (parkRows()) {
+        kpState    = KP_PRESS_DEBOUNCE;
+        kpCandidate = 0;
+        kpChangeMs = millis();
+    }
 }
 
 /* ============================================================
@@ -72,6 +137,7 @@ void keypad_init(TwoWire &bus) {
  *      - Drives one row LOW at a time
  *      - Reads column bits from expander
  *      - 300 µs settling delay ensures stable read
+ *      - Only runs while a key is down or debouncing
  * ============================================================ */
 
 static char scanMatrix() {
@@ -102,6 +168,43 @@ static char scanMatrix() {
     return 0;
 }
 
+/* ============================================================
+ *  IDLE CHECK
+ * ============================================================
+ *  KEYPAD_USE_INT = 1: free unless the ISR saw an edge, the
+ *                      INT line is still low, or the fallback
+ *                      read is due
+ *  KEYPAD_USE_INT = 0: one expander read with the rows parked
+ * ============================================================ */
+
+static bool keyActivity() {
+#if KEYPAD_USE_INT
+    unsigned long now = millis();
+
+    if (!kpEdge && digitalRead(PIN_KEYPAD_INT) == HIGH) {
+        if (now - kpFallbackMs < KEYPAD_INT_FALLBACK_MS) return false;
+        kpFallbackMs = now;
+        return parkRows();
+    }
+    kpEdge = false;
+    kpFallbackMs = now;
+    return true;
+#else
+    return parkRows();
+#endif
+}
+
+static void enterIdle() {
+    kpState = KP_IDLE;
+
+    // A key that went down while parking is caught here
+    if (parkRows()) {
+        kpState     = KP_PRESS_DEBOUNCE;
+        kpCandidate = 0;
+        kpChangeMs  = millis();
+    }
+}
+
 /* ============================================================
  *  DEBOUNCED KEYPAD READ
  * ============================================================
@@ -110,32 +213,64 @@ static char scanMatrix() {
  *      - 0 when no new key is ready
  *
  *  Behavior:
- *      - Requires 40 ms of stable key state
+ *      - IDLE costs no I²C traffic (INT mode) until an edge,
+ *        apart from the KEYPAD_INT_FALLBACK_MS read
+ *      - Requires 40 ms of stable key state (press and release)
  *      - Prevents repeats until key is released
- *      - Tracks last stable and last reported keys
  * ============================================================ */
 
 char keypad_read() {
-    char rawKey = scanMatrix();
     unsigned long now = millis();
+    char rawKey;
 
-    // Detect change in raw key state
-    if (rawKey != lastStableKey) {
-        lastStableKey = rawKey;
-        lastChangeTime = now;
-    }
+    switch (kpState) {
 
-    // Key pressed and stable
-    if (rawKey != 0 && (now - lastChangeTime) > 40) {
-        if (rawKey != lastReportedKey) {
-            lastReportedKey = rawKey;
-            return rawKey;
-        }
-    }
+        case KP_IDLE:
+            if (!keyActivity()) return 0;
+
+            rawKey = scanMatrix();
+            if (rawKey == 0) {
+                enterIdle();            // bounce or release edge
+                return 0;
+            }
+            kpCandidate = rawKey;
+            kpChangeMs  = now;
+            kpState     = KP_PRESS_DEBOUNCE;
+            return 0;
 
-    // Key released and stable
-    if (rawKey == 0 && lastReportedKey != 0 && (now - lastChangeTime) > 40) {
-        lastReportedKey = 0;
+        case KP_PRESS_DEBOUNCE:
+            rawKey = scanMatrix();
+            if (rawKey == 0) {
+                enterIdle();            // released before it settled
+                return 0;
+            }
+            if (rawKey != kpCandidate) {
+                kpCandidate = rawKey;
+                kpChangeMs  = now;
+                return 0;
+            }
+            if (now - kpChangeMs > KEYPAD_DEBOUNCE_MS) {
+                kpState = KP_HELD;
+                return rawKey;
+            }
+            return 0;
+
+        case KP_HELD:
+            if (scanMatrix() == 0) {
+                kpChangeMs = now;
+                kpState    = KP_RELEASE_DEBOUNCE;
+            }
+            return 0;
+
+        case KP_RELEASE_DEBOUNCE:
+            if (scanMatrix() != 0) {
+                kpState = KP_HELD;      // still held: no repeat
+                return 0;
+            }
+            if (now - kpChangeMs > KEYPAD_DEBOUNCE_MS) {
+                enterIdle();
+            }
+            return 0;
     }
 
     return 0;
@@ -10,7 +10,7 @@
  *      Public interface for the 4×4 matrix keypad driver using
  *      an I²C expander (PCF8574‑style). Provides:
  *
- *          • keypad_init() — attach TwoWire bus
+ *          • keypad_init() — attach TwoWire bus, arm INT line
  *          • keypad_read() — debounced, stable key events
  *
  *      Notes:
@@ -33,6 +33,20 @@
 
 #include <Wire.h>
 
+// 0 = poll the expander (works on every existing unit)
+// 1 = idle on the PCF8574 INT line. Needs a rewire: expander INT
+//     (open‑drain, active low) to PIN_KEYPAD_INT (D2), plus a
+//     pull‑up if the board lacks one. Without it the line idles
+//     HIGH; the slow fallback read below keeps the keypad usable.
+#ifndef KEYPAD_USE_INT
+#define KEYPAD_USE_INT 0
+#endif
+
+// INT mode: expander read every N ms even without an edge
+#ifndef KEYPAD_INT_FALLBACK_MS
+#define KEYPAD_INT_FALLBACK_MS 200
+#endif
+
 // Initialize keypad driver with I²C bus reference
 void keypad_init(TwoWire &bus);
 
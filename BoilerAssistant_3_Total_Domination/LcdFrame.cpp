@@ -0,0 +1,126 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – LCD Framebuffer (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: LcdFrame.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Minimal‑diff renderer behind lcd4(). Replaces the old
+ *    per‑line compare that blanked a changed line with 20 spaces
+ *    and then reprinted all 20 characters (~41 LCD bytes for a
+ *    one‑digit change on the home screen).
+ *
+ *  Architectural Notes:
+ *      - shadow[] mirrors the panel; target[] is the wanted frame
+ *      - '\0' in shadow[] marks a cell whose content is unknown
+ *      - Fixed buffers only, no allocation
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "LcdFrame.h"
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static LiquidCrystal_PCF8574* panel = nullptr;
+
+static char target[LCD_ROWS][LCD_COLS];
+static char shadow[LCD_ROWS][LCD_COLS];
+static bool dirty = false;
+
+/* ============================================================
+ *  INIT / TARGET
+ * ============================================================ */
+void lcdframe_init(LiquidCrystal_PCF8574* lcd) {
+    panel = lcd;
+    memset(target, ' ', sizeof(target));
+    memset(shadow, ' ', sizeof(shadow));
+    dirty = false;
+}
+
+void lcdframe_invalidate() {
+    memset(shadow, 0, sizeof(shadow));
+    dirty = true;
+}
+
+void lcdframe_setLine(uint8_t row, const char* text) {
+    if (row >= LCD_ROWS) return;
+
+    char* t = target[row];
+    uint8_t c = 0;
+
+    while (c < LCD_COLS && text[c]) {
+        if (t[c] != text[c]) { t[c] = text[c]; dirty = true; }
+        c++;
+    }
+    while (c < LCD_COLS) {
+        if (t[c] != ' ') { t[c] = ' '; dirty = true; }
+        c++;
+    }
+}
+
+bool lcdframe_pending() {
+    return dirty;
+}
+
+/* ============================================================
+ *  FLUSH
+ * ============================================================
+ *  Per row: find the next changed cell, extend the run while
+ *  cells differ or the unchanged gap is ≤ LCD_RUN_GAP, then
+ *  emit setCursor + the run (trimmed to the remaining budget).
+ * ============================================================ */
+uint16_t lcdframe_flush(uint16_t budget) {
+    if (!panel || !dirty) return 0;
+
+    uint16_t sent = 0;
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        const char* t = target[row];
+        char*       s = shadow[row];
+        uint8_t     c = 0;
+
+        while (c < LCD_COLS) {
+            if (t[c] == s[c]) { c++; continue; }
+
+            // Run [start, end): ends after the last changed cell
+            uint8_t start = c;
+            uint8_t end   = c + 1;
+            uint8_t gap   = 0;
+
+            for (uint8_t k = end; k < LCD_COLS; k++) {
+                if (t[k] != s[k]) {
+                    end = k + 1;
+                    gap = 0;
+                } else if (++gap > LCD_RUN_GAP) {
+                    break;
+                }
+            }
+
+            // Cursor move + at least one character must fit
+            if (sent + 2 > budget) return sent;
+
+            uint8_t len = end - start;
+            if (sent + 1 + len > budget) len = (uint8_t)(budget - sent - 1);
+
+            panel->setCursor(start, row);
+            for (uint8_t k = 0; k < len; k++) {
+                panel->write((uint8_t)t[start + k]);
+                s[start + k] = t[start + k];
+            }
+            sent += 1 + len;
+
+            if (start + len < end) return sent;     // budget spent mid‑run
+            c = end;
+        }
+    }
+
+    dirty = false;
+    return sent;
+}
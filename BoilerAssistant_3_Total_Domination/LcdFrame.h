@@ -0,0 +1,69 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – LCD Framebuffer API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: LcdFrame.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Shadow framebuffer for the 20×4 LCD. Screens write whole
+ *    lines into the target frame; lcdframe_flush() compares it
+ *    with what the panel is showing and sends only the changed
+ *    runs (one cursor move + the changed characters each).
+ *
+ *    Cost model (bytes on the HD44780 bus, each = 2 nibbles
+ *    over the PCF8574 backpack):
+ *      cursor move = 1, character = 1
+ *    Runs separated by ≤ LCD_RUN_GAP unchanged cells are merged,
+ *    since rewriting them is no dearer than a cursor move.
+ *
+ *    A flush stops once its byte budget is spent; the rest of
+ *    the difference goes out on the next flush.
+ *
+ *  Architectural Notes:
+ *      - Lines shorter than 20 columns are padded with spaces
+ *      - lcdframe_invalidate() after anything that draws behind
+ *        the framebuffer's back (boot screen, lcd.clear())
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef LCD_FRAME_H
+#define LCD_FRAME_H
+
+#include <Arduino.h>
+#include <LiquidCrystal_PCF8574.h>
+
+#define LCD_COLS 20
+#define LCD_ROWS 4
+
+// Max LCD bytes per flush (~40 µs each at 400 kHz I²C)
+#ifndef LCD_FRAME_BUDGET
+#define LCD_FRAME_BUDGET 64
+#endif
+
+// Merge changed runs separated by this many unchanged cells or fewer
+#ifndef LCD_RUN_GAP
+#define LCD_RUN_GAP 1
+#endif
+
+// Attach the panel; assumes it was just cleared
+void lcdframe_init(LiquidCrystal_PCF8574* lcd);
+
+// Set one target line (NUL‑terminated, padded / cut to 20)
+void lcdframe_setLine(uint8_t row, const char* text);
+
+// Panel content unknown → blank shadow, next flush redraws all
+void lcdframe_invalidate();
+
+// Send up to `budget` bytes of difference. Returns bytes sent.
+uint16_t lcdframe_flush(uint16_t budget = LCD_FRAME_BUDGET);
+
+// True while the panel differs from the target frame
+bool lcdframe_pending();
+
+#endif
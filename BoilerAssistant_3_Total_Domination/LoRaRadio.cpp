@@ -55,6 +55,8 @@
 #include "EnvironmentalLogic.h"  
 #include "SystemData.h"           
 #include "LoRaRadio.h"
+#include "SystemFields.h"
+#include "Telemetry.h"
 #include <LoRa.h>
 
 
@@ -107,11 +109,25 @@ void lora_loop() {
         if (len >= 4) lora_handleCommand(buf, len);
     }
 
-    // Transmit telemetry every 2 seconds
-    static unsigned long lastTx = 0;
-    if (millis() - lastTx > 2000) {
-        lora_sendTelemetry();
-        lastTx = millis();
+    // Transmit telemetry at most every 2 s, and only when a field
+    // in the packet changed (30 s keep‑alive otherwise)
+    static unsigned long lastTx  = 0;
+    static SysFieldMask  pending = SF_ALL;
+
+    const SysFieldMask TELEMETRY =
+        SF_BIT(EXHAUST_SMOOTH) | SF_BIT(FAN_FINAL) | SF_BIT(BURN_STATE) |
+        SF_BIT(ENV_TEMP) | SF_BIT(ENV_HUMIDITY) |
+        SF_BIT(WATER_COUNT) | SF_BIT(WATER_TEMP);
+
+    unsigned long now = millis();
+    if (now - lastTx > 2000) {
+        pending |= sysf_take(SYSF_LORA);
+
+        if ((pending & TELEMETRY) || now - lastTx > 30000) {
+            lora_sendTelemetry();
+            pending = 0;
+            lastTx  = now;
+        }
     }
 }
 
@@ -122,26 +138,29 @@ void lora_loop() {
 static void lora_sendTelemetry() {
     uint8_t pkt[16];
 
+    TelemetrySnapshot snap;
+    telemetry_read(&snap);
+
     pkt[0] = 0x01; // version
 
-    uint16_t ex = sys.exhaustSmoothF * 10;
+    uint16_t ex = snap.exhaustF * 10;
     pkt[1] = ex >> 8;
     pkt[2] = ex & 0xFF;
 
-    pkt[3] = sys.fanFinal;
-    pkt[4] = sys.burnState;
+    pkt[3] = snap.fanPercent;
+    pkt[4] = snap.burnState;
 
-    uint16_t t = sys.envTempF * 10;
+    uint16_t t = snap.envTempF * 10;
     pkt[5] = t >> 8;
     pkt[6] = t & 0xFF;
 
-    pkt[7] = sys.waterProbeCount;
+    pkt[7] = snap.waterProbeCount;
 
-    uint16_t w = (sys.waterProbeCount > 0) ? (sys.waterTempF[0] * 10) : 0;
+    uint16_t w = (snap.waterProbeCount > 0) ? (snap.waterTempF[0] * 10) : 0;
     pkt[8]  = w >> 8;
     pkt[9]  = w & 0xFF;
 
-    uint16_t h = sys.envHumidity * 10;
+    uint16_t h = snap.envHumidity * 10;
     pkt[10] = h >> 8;
     pkt[11] = h & 0xFF;
 
@@ -168,15 +187,16 @@ static void lora_handleCommand(uint8_t* pkt, uint8_t len) {
     uint8_t cmd = pkt[0];
     uint16_t value = (pkt[1] << 8) | pkt[2];
 
+    // Typed setters clamp to the registry range
     switch (cmd) {
-        case 0x01: sys.exhaustSetpoint       = value; break;
-        case 0x02: sys.deadbandF             = value; break;
-        case 0x03: sys.clampMinPercent       = value; break;
-        case 0x04: sys.clampMaxPercent       = value; break;
-        case 0x05: sys.boostTimeSeconds      = value; break;
-        case 0x06: sys.emberGuardianTimerMinutes = value; break;
-        case 0x07: sys.flueLowThreshold      = value; break;
-        case 0x08: sys.flueRecoveryThreshold = value; break;
+        case 0x01: sysf_setI(SF_EXHAUST_SETPOINT, value); break;
+        case 0x02: sysf_setI(SF_DEADBAND,         value); break;
+        case 0x03: sysf_setI(SF_CLAMP_MIN,        value); break;
+        case 0x04: sysf_setI(SF_CLAMP_MAX,        value); break;
+        case 0x05: sysf_setI(SF_BOOST_TIME,       value); break;
+        case 0x06: sysf_setI(SF_GUARDIAN_MINUTES, value); break;
+        case 0x07: sysf_setI(SF_FLUE_LOW,         value); break;
+        case 0x08: sysf_setI(SF_FLUE_RECOVERY,    value); break;
         default: return;
     }
 
@@ -0,0 +1,276 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Loop Timing Instrumentation (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: LoopPerf.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Cycle‑accurate per‑stage timing for the main loop. Uses the
+ *    Cortex‑M4 DWT cycle counter on the UNO R4 (RA4M1) and falls
+ *    back to micros() wherever the CMSIS DWT block is unavailable.
+ *
+ *    JSON layout (perf_writeJson):
+ *      {
+ *        "tb":"dwt", "up":<ms>,
+ *        "stages":{ "<name>":{"n","min","avg","max","h":[…]} … },
+ *        "sched": { "<task>":{"runs","late","over","defer",
+ *                             "late_ms","max_us"} … }
+ *      }
+ *
+ *  Architectural Notes:
+ *      - Durations are stored in µs regardless of timebase
+ *      - DWT CYCCNT wraps after ~89 s at 48 MHz; single stage
+ *        durations are far below that
+ *      - No dynamic allocation; the JSON never exists as one
+ *        string, so its size is bounded only by the sink
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "LoopPerf.h"
+#include "Scheduler.h"
+
+#include <stdarg.h>
+
+#if defined(DWT) && defined(CoreDebug) && defined(DWT_CTRL_CYCCNTENA_Msk)
+#define PERF_USE_DWT 1
+#else
+#define PERF_USE_DWT 0
+#endif
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static PerfStats stats[PERF_STAGE_COUNT];
+static uint32_t  stageStart[PERF_STAGE_COUNT];
+
+static const char* const stageNames[PERF_STAGE_COUNT] = {
+    "keypad",
+    "exhaust",
+    "water",
+    "env",
+    "burn",
+    "fan",
+    "wifiapi",
+    "mqtt",
+    "ui",
+    "provision"
+};
+
+#if PERF_USE_DWT
+static uint32_t cyclesPerUs = 48;
+#endif
+
+/* ============================================================
+ *  TIMEBASE
+ * ============================================================ */
+uint32_t perf_timestamp() {
+#if PERF_USE_DWT
+    return DWT->CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+uint32_t perf_elapsedUs(uint32_t startStamp) {
+#if PERF_USE_DWT
+    return (DWT->CYCCNT - startStamp) / cyclesPerUs;
+#else
+    return micros() - startStamp;
+#endif
+}
+
+uint32_t perf_elapsedCycles(uint32_t startStamp) {
+#if PERF_USE_DWT
+    return DWT->CYCCNT - startStamp;
+#else
+    (void)startStamp;
+    return 0;
+#endif
+}
+
+const char* perf_timebase() {
+#if PERF_USE_DWT
+    return "dwt";
+#else
+    return "micros";
+#endif
+}
+
+/* ============================================================
+ *  INIT / RESET
+ * ============================================================ */
+void perf_reset() {
+    for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+        memset(&stats[i], 0, sizeof(PerfStats));
+        stats[i].minUs = 0xFFFFFFFFUL;
+    }
+}
+
+void perf_init() {
+#if PERF_USE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cyclesPerUs = SystemCoreClock / 1000000UL;
+    if (cyclesPerUs == 0) cyclesPerUs = 1;
+#endif
+    perf_reset();
+}
+
+/* ============================================================
+ *  STAGE BRACKETS
+ * ============================================================ */
+static uint8_t bucketFor(uint32_t us) {
+    uint8_t b = 0;
+    while (us >= 4 && b < PERF_HIST_BUCKETS - 1) {
+        us >>= 2;
+        b++;
+    }
+    return b;
+}
+
+void perf_begin(PerfStage s) {
+    if (s >= PERF_STAGE_COUNT) return;
+    stageStart[s] = perf_timestamp();
+}
+
+void perf_end(PerfStage s) {
+    if (s >= PERF_STAGE_COUNT) return;
+
+    uint32_t us = perf_elapsedUs(stageStart[s]);
+    PerfStats& st = stats[s];
+
+    st.count++;
+    st.totalUs += us;
+    if (us < st.minUs) st.minUs = us;
+    if (us > st.maxUs) st.maxUs = us;
+    st.hist[bucketFor(us)]++;
+}
+
+/* ============================================================
+ *  ACCESSORS
+ * ============================================================ */
+const PerfStats* perf_getStats(PerfStage s) {
+    if (s >= PERF_STAGE_COUNT) return nullptr;
+    return &stats[s];
+}
+
+const char* perf_stageName(PerfStage s) {
+    if (s >= PERF_STAGE_COUNT) return "?";
+    return stageNames[s];
+}
+
+uint32_t perf_avgUs(PerfStage s) {
+    if (s >= PERF_STAGE_COUNT || stats[s].count == 0) return 0;
+    return (uint32_t)(stats[s].totalUs / stats[s].count);
+}
+
+/* ============================================================
+ *  JSON EXPORT
+ * ============================================================ */
+
+/*
+ * Output is gathered in a PERF_JSON_CHUNK buffer and flushed to the
+ * sink whenever the next piece would not fit. Every piece is bounded
+ * (names are clipped to 15 chars, numbers are 32‑bit), the largest
+ * being a "sched" entry at ~145 bytes, so no piece is ever split.
+ * A null sink only counts, which is how perf_jsonLength() works.
+ */
+struct PerfJsonWriter {
+    Print* out;
+    size_t total;
+    size_t pos;
+    char   buf[PERF_JSON_CHUNK];
+};
+
+static void jsonFlush(PerfJsonWriter& w) {
+    if (w.out && w.pos) w.out->write((const uint8_t*)w.buf, w.pos);
+    w.total += w.pos;
+    w.pos = 0;
+}
+
+static void jsonPiece(PerfJsonWriter& w, const char* fmt, ...) {
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(w.buf + w.pos, sizeof(w.buf) - w.pos, fmt, ap);
+        va_end(ap);
+
+        if (n < 0) return;
+        if ((size_t)n < sizeof(w.buf) - w.pos) {
+            w.pos += (size_t)n;
+            return;
+        }
+        if (w.pos == 0) {                   // oversize piece: clip it
+            w.pos = sizeof(w.buf) - 1;
+            return;
+        }
+        jsonFlush(w);
+    }
+}
+
+static size_t perf_emitJson(Print* out, uint32_t upMs) {
+    PerfJsonWriter w;
+    w.out   = out;
+    w.total = 0;
+    w.pos   = 0;
+
+    jsonPiece(w, "{\"tb\":\"%s\",\"up\":%lu,\"stages\":{",
+              perf_timebase(), (unsigned long)upMs);
+
+    for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+        const PerfStats& st = stats[i];
+
+        jsonPiece(w,
+                  "%s\"%.15s\":{\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"max\":%lu,\"h\":[",
+                  i ? "," : "",
+                  stageNames[i],
+                  (unsigned long)st.count,
+                  (unsigned long)(st.count ? st.minUs : 0),
+                  (unsigned long)perf_avgUs((PerfStage)i),
+                  (unsigned long)st.maxUs);
+
+        for (uint8_t b = 0; b < PERF_HIST_BUCKETS; b++) {
+            jsonPiece(w, "%s%lu", b ? "," : "", (unsigned long)st.hist[b]);
+        }
+        jsonPiece(w, "]}");
+    }
+
+    jsonPiece(w, "},\"sched\":{");
+
+    for (uint8_t i = 0; i < sched_taskCount(); i++) {
+        const SchedTask* t = sched_getTask(i);
+
+        jsonPiece(w,
+                  "%s\"%.15s\":{\"runs\":%lu,\"late\":%lu,\"over\":%lu,"
+                  "\"defer\":%lu,\"late_ms\":%lu,\"max_us\":%lu}",
+                  i ? "," : "",
+                  t->name,
+                  (unsigned long)t->runs,
+                  (unsigned long)t->lateStarts,
+                  (unsigned long)t->overruns,
+                  (unsigned long)t->deferrals,
+                  t->maxLatenessMs,
+                  t->maxRunUs);
+    }
+
+    jsonPiece(w, "}}");
+    jsonFlush(w);
+
+    return w.total;
+}
+
+size_t perf_writeJson(Print& out, uint32_t upMs) {
+    return perf_emitJson(&out, upMs);
+}
+
+size_t perf_jsonLength(uint32_t upMs) {
+    return perf_emitJson(nullptr, upMs);
+}
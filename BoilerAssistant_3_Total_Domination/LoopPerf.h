@@ -0,0 +1,105 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Loop Timing Instrumentation API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: LoopPerf.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Per‑stage timing instrumentation for the main loop. Each
+ *    numbered loop stage is bracketed with perf_begin()/perf_end()
+ *    and accumulates:
+ *
+ *      • sample count
+ *      • min / avg / max duration (µs)
+ *      • log‑bucket histogram (base 4: 1, 4, 16, 64 … µs)
+ *
+ *    Timebase:
+ *      • RA4M1 DWT cycle counter when CMSIS exposes it
+ *      • micros() fallback on any other core
+ *
+ *    Stats are exported as compact JSON for:
+ *      • MQTT topic  boiler/perf
+ *      • HTTP        GET /api/perf
+ *
+ *  Architectural Notes:
+ *      - Fixed tables, no dynamic allocation
+ *      - JSON is streamed with snprintf in PERF_JSON_CHUNK pieces
+ *        (no ArduinoJson document, no whole‑payload buffer)
+ *      - All implementation resides in LoopPerf.cpp
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef LOOP_PERF_H
+#define LOOP_PERF_H
+
+#include <Arduino.h>
+
+/* ============================================================
+ *  STAGES
+ * ============================================================ */
+typedef enum {
+    PERF_KEYPAD = 0,
+    PERF_EXHAUST,
+    PERF_WATER,
+    PERF_ENV,
+    PERF_BURN,
+    PERF_FAN,
+    PERF_WIFIAPI,
+    PERF_MQTT,
+    PERF_UI,
+    PERF_PROVISION,
+    PERF_STAGE_COUNT
+} PerfStage;
+
+// Bucket b holds durations in [4^b, 4^(b+1)) µs; the last bucket is open‑ended
+#define PERF_HIST_BUCKETS 11
+
+struct PerfStats {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t hist[PERF_HIST_BUCKETS];
+};
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Enable the cycle counter and clear all stats
+void perf_init();
+
+// Bracket one stage execution
+void perf_begin(PerfStage s);
+void perf_end(PerfStage s);
+
+// Stats access
+const PerfStats* perf_getStats(PerfStage s);
+const char*      perf_stageName(PerfStage s);
+uint32_t         perf_avgUs(PerfStage s);
+void             perf_reset();
+
+// "dwt" or "micros"
+const char* perf_timebase();
+
+// Raw timestamp + conversion (for ad‑hoc benchmarks)
+uint32_t perf_timestamp();
+uint32_t perf_elapsedUs(uint32_t startStamp);
+uint32_t perf_elapsedCycles(uint32_t startStamp);   // 0 without DWT
+
+// Largest single write perf_writeJson() hands to its sink
+#define PERF_JSON_CHUNK 192
+
+// Stream all stages (+ scheduler stats) as JSON, PERF_JSON_CHUNK bytes
+// at a time. upMs is the "up" field; pass the same value to
+// perf_jsonLength() first when the sink needs a length up front.
+size_t perf_writeJson(Print& out, uint32_t upMs);
+size_t perf_jsonLength(uint32_t upMs);
+
+#endif
@@ -13,18 +13,29 @@
  *    Architecture (TDA) for all network‑side communication.
  *
  *    Responsibilities:
- *      • Non‑blocking MQTT RX/TX loop
- *      • State, settings, water, and outdoor telemetry topics
- *      • Home Assistant auto‑discovery publishing
- *      • CRC‑validated remote command handling
+ *      • MQTT RX/TX loop (only connecting blocks, see LINK STATE)
+ *      • State, settings, water, and outdoor telemetry topics,
+ *        report‑on‑change: discrete fields on any change, analog
+ *        fields past a per‑field deadband, plus a heartbeat
+ *      • Deadbands / heartbeats retunable on boiler/cmd/telemetry
+ *      • Loop timing statistics on boiler/perf (LoopPerf)
+ *      • Outage backfill on boiler/history (TelemetryHistory)
+ *      • Home Assistant discovery: incremental cursor, skips
+ *        entities whose retained config is already current
+ *      • Table‑driven remote commands: range‑checked, persisted
+ *        on change, acknowledged on boiler/ack/<name>
  *      • Full SystemData integration (no legacy globals)
  *
  *    Architectural Notes:
- *      - All MQTT operations are non‑blocking
+ *      - RX/TX and publishing never wait on the broker; the
+ *        connect and DNS calls do block (bounds in MQTTClient.h)
+ *        and run as scheduler blocking sections, so the control
+ *        tick keeps running from the timer ISR underneath them
  *      - No dynamic allocation beyond ArduinoJson buffers
  *      - SystemData is the single source of truth
  *      - No burn logic, UI logic, or EEPROM logic lives here
- *      - Reconnect logic is rate‑limited and deterministic
+ *      - Connection is a stepped state machine with bounded
+ *        timeouts and exponential backoff + jitter
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -43,11 +54,19 @@
 #include <ArduinoJson.h>
 #include <WiFiS3.h>
 #include <ArduinoMqttClient.h>
+#include <Modem.h>
 
 #include "MQTTClient.h"
 #include "EEPROMStorage.h"
 #include "WiFiProvisioning.h"
 #include "RuntimeCredentials.h"
+#include "LoopPerf.h"
+#include "Scheduler.h"
+#include "SystemFields.h"
+#include "Telemetry.h"
+#include "TelemetryHistory.h"
+
+#include <stddef.h>
 
 #ifndef PROBE_ROLE_COUNT
 #define PROBE_ROLE_COUNT 8
@@ -70,6 +89,9 @@ static const char* TOPIC_STATE    = "boiler/state";
 static const char* TOPIC_SETTINGS = "boiler/settings";
 static const char* TOPIC_WATER    = "boiler/water";
 static const char* TOPIC_OUTDOOR  = "boiler/outdoor";
+static const char* TOPIC_PERF     = "boiler/perf";
+static const char* TOPIC_TELEMETRY_CFG = "boiler/telemetry_cfg";
+static const char* TOPIC_HISTORY  = "boiler/history";
 
 static const char* HA_DISCOVERY_PREFIX = "homeassistant";
 static const char* HA_DEVICE_ID        = "boiler_assistant";
@@ -82,42 +104,139 @@ static const char* HA_DEVICE_SW    = "3.3";
 WiFiClient wifiClient;
 MqttClient mqtt(wifiClient);
 
-static unsigned long lastStateFastMs      = 0;
-static unsigned long lastStateSlowMs      = 0;
-static unsigned long lastWaterMs          = 0;
-static unsigned long lastSettingsMs       = 0;
-static unsigned long lastOutdoorBmeMs     = 0;
-static unsigned long lastReconnectAttempt = 0;
+static unsigned long lastPerfMs           = 0;
+static unsigned long lastHistoryMs        = 0;
+
+/* ============================================================
+ *  LINK STATE
+ *  ------------------------------------------------------------
+ *  Connecting is NOT non‑blocking. At most one blocking modem
+ *  call per mqtt_loop() pass, each bounded:
+ *
+ *    RESOLVE  hostByName()    ≤ MQTT_DNS_TIMEOUT_MS     (1 s)
+ *    CONNECT  mqtt.connect()  ≤ MQTT_TCP_TIMEOUT_MS +
+ *                               MQTT_CONNACK_TIMEOUT_MS (2 s)
+ *
+ *  Both run inside sched_blockingBegin()/End(): task_control is
+ *  serviced from the scheduler's timer ISR meanwhile, so fan and
+ *  damper keep updating (≤ 1000/SCHED_SERVICE_HZ ms late). Every
+ *  other task, UI and keypad included, does stall for that long.
+ *
+ *    OFFLINE → RESOLVE → CONNECT → SESSION → UP
+ *                 │          │                 │
+ *                 └──────────┴──→ BACKOFF ←────┘
+ *
+ *  Failures back off exponentially (MQTT_BACKOFF_MIN_MS doubling
+ *  to MQTT_BACKOFF_MAX_MS) with ±MQTT_BACKOFF_JITTER_PCT jitter.
+ * ============================================================ */
+enum MqttLinkState : uint8_t {
+    LINK_OFFLINE,     // WiFi down or no broker configured
+    LINK_RESOLVE,     // broker name → IP (cached)
+    LINK_CONNECT,     // TCP + CONNECT + CONNACK, bounded
+    LINK_SESSION,     // subscriptions, discovery, full republish
+    LINK_UP,
+    LINK_BACKOFF
+};
+
+static MqttLinkState linkState       = LINK_OFFLINE;
+static IPAddress     brokerIp;
+static bool          brokerResolved  = false;
+static uint8_t       linkFailures    = 0;       // since the last good session
+static uint32_t      backoffMs       = MQTT_BACKOFF_MIN_MS;
+static uint32_t      backoffWaitMs   = 0;
+static unsigned long backoffStartMs  = 0;
+static bool          linkLost        = false;   // failed since the last session
+
+// Fields changed since they were last published (SystemFields)
+static SysFieldMask pendingFields = SF_ALL;
+
+/* ============================================================
+ *  REPORT-ON-CHANGE TABLES
+ *  ------------------------------------------------------------
+ *  Discrete fields (burn state, flags, counts) publish on any
+ *  change via the SystemFields dirty mask. Analog fields ignore
+ *  their dirty bit and are compared against the value last
+ *  published on that topic:
+ *
+ *      |now − sent| > max(abs, rel × |sent|)
+ *
+ *  Deadbands and heartbeats live in RAM; a retained command on
+ *  boiler/cmd/telemetry is replayed on every connect.
+ * ============================================================ */
+enum MqttTelemetryTopic : uint8_t {
+    TT_STATE,
+    TT_WATER,
+    TT_OUTDOOR,
+    TT_SETTINGS,
+    TT_COUNT
+};
+
+struct TelemetryTopic {
+    const char*        key;
+    SysFieldMask       fields;       // everything the payload carries
+    SysFieldMask       analog;       // subset gated by deadbands instead
+    uint32_t           minIntervalMs;
+    uint32_t           heartbeatMs;
+    unsigned long      lastMs;
+    TelemetrySnapshot  sent;         // snapshot the last payload was built from
+};
+
+static TelemetryTopic topics[TT_COUNT] = {
+    { "state",    SF_MASK_STATE,    SF_BIT(EXHAUST_SMOOTH) | SF_BIT(FAN_FINAL),
+      MQTT_MIN_INTERVAL_MS, MQTT_HB_STATE_MS,    0, {} },
+    { "water",    SF_MASK_WATER,    SF_BIT(WATER_TEMP),
+      MQTT_MIN_INTERVAL_MS, MQTT_HB_WATER_MS,    0, {} },
+    { "outdoor",  SF_MASK_OUTDOOR,  SF_BIT(ENV_TEMP) | SF_BIT(ENV_HUMIDITY) | SF_BIT(ENV_PRESSURE),
+      MQTT_MIN_INTERVAL_MS, MQTT_HB_OUTDOOR_MS,  0, {} },
+    { "settings", SF_MASK_SETTINGS, 0,
+      MQTT_MIN_INTERVAL_MS, MQTT_HB_SETTINGS_MS, 0, {} },
+};
+
+struct TelemetryDeadband {
+    const char* key;
+    uint8_t     topic;
+    bool        isInt;               // int member, else float
+    uint16_t    offset;              // into TelemetrySnapshot
+    uint8_t     count;
+    float       absBand;
+    float       relBand;
+};
+
+#define TDB(key, topic, member, count, isInt, absBand, relBand) \
+    { key, topic, isInt, (uint16_t)offsetof(TelemetrySnapshot, member), count, absBand, relBand }
+
+static TelemetryDeadband deadbands[] = {
+    TDB("exhaust",      TT_STATE,   exhaustF,    1,                false, MQTT_DB_EXHAUST_F,    0.0f),
+    TDB("fan",          TT_STATE,   fanPercent,  1,                true,  MQTT_DB_FAN_PCT,      0.0f),
+    TDB("water",        TT_WATER,   waterTempF,  MAX_WATER_PROBES, false, MQTT_DB_WATER_F,      0.0f),
+    TDB("outdoor_temp", TT_OUTDOOR, envTempF,    1,                false, MQTT_DB_OUTDOOR_F,    0.0f),
+    TDB("outdoor_hum",  TT_OUTDOOR, envHumidity, 1,                false, MQTT_DB_HUMIDITY_PCT, 0.0f),
+    TDB("outdoor_pres", TT_OUTDOOR, envPressure, 1,                false, 0.0f,                 MQTT_DB_PRESSURE_REL),
+};
+
+#undef TDB
+
+static const uint8_t DEADBAND_COUNT = sizeof(deadbands) / sizeof(deadbands[0]);
 
 // Forward declarations
-static void mqtt_publishState();
+static void mqtt_publishState(const TelemetrySnapshot& t);
 static void mqtt_publishSettings();
-static void mqtt_publishWater();
-static void mqtt_publishOutdoor();
+static void mqtt_publishWater(const TelemetrySnapshot& t);
+static void mqtt_publishOutdoor(const TelemetrySnapshot& t);
+static void mqtt_publishPerf();
+static void mqtt_publishTelemetryConfig();
+static void mqtt_publishHistory(unsigned long now);
+static bool handleTelemetryTuning(StaticJsonDocument<256>& doc);
 static void mqtt_onMessage(int messageSize);
-static void mqtt_reconnect();
-static void publishDiscovery();
-
-static void publishDiscoverySensor(
-    const char* objectId, const char* name, const char* stateTopic,
-    const char* valueTemplate, const char* unit,
-    const char* deviceClass, const char* icon = nullptr
-);
-
-static void publishDiscoveryNumber(
-    const char* objectId, const char* name,
-    const char* cmdTopic, const char* stateTopic,
-    const char* unit, float minVal, float maxVal, float step,
-    const char* deviceClass = nullptr, const char* icon = nullptr
-);
-
-static void publishDiscoverySwitch(
-    const char* objectId, const char* name,
-    const char* cmdTopic, const char* stateTopic,
-    const char* icon = nullptr
-);
-
-static void handleCommandTopic(const String& topic, StaticJsonDocument<256>& doc);
+static bool mqtt_link(unsigned long now);
+static void discovery_begin(unsigned long now);
+static void discovery_step(unsigned long now);
+static bool discovery_onRetained(const String& topic, int messageSize);
+static void discovery_status(JsonObject out);
+static bool discovery_done();
+
+static void handleCommand(const char* name, StaticJsonDocument<256>& doc);
+static void checkCommandTable();
 
 // ============================================================
 // INIT
@@ -128,89 +247,254 @@ void mqtt_init() {
     mqtt.setUsernamePassword(prov_mqtt_user, prov_mqtt_pass);
     mqtt.setKeepAliveInterval(15);
     mqtt.onMessage(mqtt_onMessage);
+
+    checkCommandTable();
+}
+
+// ============================================================
+// DEADBANDS
+// ============================================================
+
+static float snapshotValue(const TelemetrySnapshot& t, const TelemetryDeadband& d, uint8_t idx) {
+    const uint8_t* p = (const uint8_t*)&t + d.offset;
+    if (d.isInt) return (float)((const int*)p)[idx];
+    return ((const float*)p)[idx];
+}
+
+// True when any analog field of the topic moved past its deadband
+static bool deadbandExceeded(uint8_t topic, const TelemetrySnapshot& now,
+                             const TelemetrySnapshot& sent) {
+    for (uint8_t d = 0; d < DEADBAND_COUNT; d++) {
+        const TelemetryDeadband& db = deadbands[d];
+        if (db.topic != topic) continue;
+
+        for (uint8_t i = 0; i < db.count; i++) {
+            float a = snapshotValue(now,  db, i);
+            float b = snapshotValue(sent, db, i);
+
+            if (isnan(a) || isnan(b)) {
+                if (isnan(a) != isnan(b)) return true;
+                continue;
+            }
+
+            float band = db.relBand * fabsf(b);
+            if (band < db.absBand) band = db.absBand;
+
+            if (fabsf(a - b) > band) return true;
+        }
+    }
+    return false;
 }
 
 // ============================================================
 // LOOP
 // ============================================================
 
+bool mqtt_outage() {
+    return linkLost || wifi_prov_isAPMode();
+}
+
 void mqtt_loop() {
     if (wifi_prov_isAPMode()) return;
-    if (!sys.wifiOK) return;
-    if (WiFi.status() != WL_CONNECTED) return;
 
-    mqtt_reconnect();
-    if (!mqtt.connected()) return;
+    unsigned long now = millis();
+
+    // Outage samples for boiler/history are taken by task_network
+    // via mqtt_outage(), which also runs in AP mode
+    if (!mqtt_link(now)) return;
 
     mqtt.poll();
 
-    unsigned long now = millis();
+    discovery_step(now);
 
-    if (now - lastWaterMs > 1000) {
-        mqtt_publishWater();
-        lastWaterMs = now;
-    }
+    pendingFields |= sysf_take(SYSF_MQTT);
 
-    if (now - lastStateFastMs > 1000) {
-        mqtt_publishState();
-        lastStateFastMs = now;
-    }
+    TelemetrySnapshot snap;
+    telemetry_read(&snap);
+
+    for (uint8_t i = 0; i < TT_COUNT; i++) {
+        TelemetryTopic& tp = topics[i];
+
+        if (now - tp.lastMs < tp.minIntervalMs) continue;
+
+        bool due = (pendingFields & tp.fields & ~tp.analog) ||
+                   deadbandExceeded(i, snap, tp.sent) ||
+                   (now - tp.lastMs >= tp.heartbeatMs);
+
+        // Guardian countdown ticks every second while active
+        if (i == TT_STATE && snap.guardianActive) due = true;
+
+        if (!due) continue;
+
+        switch (i) {
+            case TT_STATE:    mqtt_publishState(snap);   break;
+            case TT_WATER:    mqtt_publishWater(snap);   break;
+            case TT_OUTDOOR:  mqtt_publishOutdoor(snap); break;
+            case TT_SETTINGS: mqtt_publishSettings();    break;
+        }
 
-    if (now - lastStateSlowMs > 30000) {
-        mqtt_publishState();
-        lastStateSlowMs = now;
+        pendingFields &= ~tp.fields;
+        tp.sent   = snap;
+        tp.lastMs = now;
     }
 
-    if (now - lastSettingsMs > 60000) {
-        mqtt_publishSettings();
-        lastSettingsMs = now;
+    if (now - lastPerfMs > 60000) {
+        mqtt_publishPerf();
+        lastPerfMs = now;
     }
 
-    if (now - lastOutdoorBmeMs > 1000) {
-        mqtt_publishOutdoor();
-        lastOutdoorBmeMs = now;
+    // Backfill after discovery so the two never compete for the link
+    if (discovery_done() && history_count() > 0 &&
+        now - lastHistoryMs >= HISTORY_DRAIN_INTERVAL_MS) {
+        mqtt_publishHistory(now);
+        lastHistoryMs = now;
     }
 }
 
 // ============================================================
-// RECONNECT
+// LINK
 // ============================================================
 
-static void mqtt_reconnect() {
-    unsigned long now = millis();
+static uint32_t jitterRand() {
+    static uint32_t x = 0;
+    if (x == 0) x = micros() | 1;       // seeded by boot timing
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+static void link_fail(unsigned long now, const char* why) {
+    mqtt.stop();
+    linkFailures++;
+    linkLost = true;
+
+    // Broker may have moved: look it up again every few failures
+    if (linkFailures % MQTT_DNS_REFRESH_FAILS == 0) brokerResolved = false;
+
+    uint32_t span = backoffMs / 100UL * MQTT_BACKOFF_JITTER_PCT;
+    backoffWaitMs = backoffMs - span + (span ? jitterRand() % (2 * span + 1) : 0);
+    backoffStartMs = now;
+
+    backoffMs = (backoffMs >= MQTT_BACKOFF_MAX_MS / 2) ? MQTT_BACKOFF_MAX_MS
+                                                      : backoffMs * 2;
+
+    Serial.print("MQTT: ");
+    Serial.print(why);
+    Serial.print(" failed, retry in ");
+    Serial.print(backoffWaitMs / 1000UL);
+    Serial.println(" s");
+
+    linkState = LINK_BACKOFF;
+}
+
+// Advance the connection by at most one step. True while the session is up.
+static bool mqtt_link(unsigned long now) {
+    if (!sys.wifiOK || WiFi.status() != WL_CONNECTED || prov_mqtt_server[0] == 0) {
+        if (linkState == LINK_UP) {
+            mqtt.stop();
+            linkLost = true;
+        }
+        if (linkState != LINK_BACKOFF) linkState = LINK_OFFLINE;
+        return false;
+    }
+
+    switch (linkState) {
+
+        case LINK_OFFLINE:
+            linkState = LINK_RESOLVE;
+            return false;
+
+        case LINK_RESOLVE:
+            if (!brokerResolved) {
+                if (!brokerIp.fromString(prov_mqtt_server)) {
+                    // The AT layer otherwise waits up to 10 s for the reply
+                    modem.timeout(MQTT_DNS_TIMEOUT_MS);
+                    sched_blockingBegin();
+                    int ok = WiFi.hostByName(prov_mqtt_server, brokerIp);
+                    sched_blockingEnd();
+                    modem.timeout(MQTT_MODEM_TIMEOUT_MS);
+
+                    if (ok != 1) {
+                        link_fail(now, "resolve");
+                        return false;
+                    }
+                }
+                brokerResolved = true;
+            }
+            linkState = LINK_CONNECT;
+            return false;               // connect on the next pass
+
+        case LINK_CONNECT: {
+            wifiClient.setConnectionTimeout(MQTT_TCP_TIMEOUT_MS);
+            mqtt.setConnectionTimeout(MQTT_CONNACK_TIMEOUT_MS);
 
-    if (!sys.wifiOK) return;
-    if (WiFi.status() != WL_CONNECTED) return;
-    if (mqtt.connected()) return;
-    if (now - lastReconnectAttempt < 30000) return;
+            sched_blockingBegin();
+            bool connected = mqtt.connect(brokerIp, MQTT_PORT);
+            sched_blockingEnd();
 
-    lastReconnectAttempt = now;
+            if (!connected) {
+                link_fail(now, "connect");
+                return false;
+            }
+            linkState = LINK_SESSION;
+            return false;
+        }
+
+        case LINK_SESSION:
+            mqtt.subscribe("boiler/cmd/#");
+            discovery_begin(now);
+            mqtt_publishTelemetryConfig();
+            pendingFields = SF_ALL;     // fresh session: publish everything
+
+            linkFailures = 0;
+            linkLost     = false;
+            backoffMs    = MQTT_BACKOFF_MIN_MS;
+            linkState    = LINK_UP;
 
-    if (mqtt.connect(prov_mqtt_server, MQTT_PORT)) {
-        mqtt.subscribe("boiler/cmd/#");
-        publishDiscovery();
+            Serial.println("MQTT: connected");
+            return true;
+
+        case LINK_UP:
+            if (!mqtt.connected()) {
+                link_fail(now, "session");
+                return false;
+            }
+            return true;
+
+        case LINK_BACKOFF:
+            if (now - backoffStartMs >= backoffWaitMs) linkState = LINK_RESOLVE;
+            return false;
     }
+
+    return false;
 }
 
 // ============================================================
 // PUBLISHERS
 // ============================================================
 
-static void mqtt_publishState() {
+static void mqtt_publishState(const TelemetrySnapshot& t) {
     StaticJsonDocument<1024> doc;
 
-    doc["exhaust"]    = sys.exhaustSmoothF;
-    doc["fan"]        = sys.fanFinal;
-    doc["fan_final"]  = sys.fanFinal;
-    doc["state"]      = sys.burnState;
+    // One control step's worth of values (see Telemetry.h)
+    doc["seq"]        = t.seq;
+
+    doc["exhaust"]    = t.exhaustF;
+    doc["fan"]        = t.fanPercent;
+    doc["fan_final"]  = t.fanPercent;
+    doc["state"]      = t.burnState;
     doc["rssi"]       = WiFi.RSSI();
 
+    // Home Assistant discovery progress
+    discovery_status(doc.createNestedObject("discovery"));
+
     const char* phaseText =
-        (sys.burnState == BURN_IDLE)        ? "IDLE" :
-        (sys.burnState == BURN_BOOST)       ? "BOOST" :
-        (sys.burnState == BURN_RAMP)        ? "RAMP" :
-        (sys.burnState == BURN_HOLD)        ? "HOLD" :
-        (sys.burnState == BURN_EMBER_GUARD) ? "EMBER_GUARD" :
+        (t.burnState == BURN_IDLE)        ? "IDLE" :
+        (t.burnState == BURN_BOOST)       ? "BOOST" :
+        (t.burnState == BURN_RAMP)        ? "RAMP" :
+        (t.burnState == BURN_HOLD)        ? "HOLD" :
+        (t.burnState == BURN_EMBER_GUARD) ? "EMBER_GUARD" :
                                               "UNKNOWN";
 
     doc["state_text"] = phaseText;
@@ -219,13 +503,13 @@ static void mqtt_publishState() {
     // Ember Guardian v3.3 unified model (ONLY new fields)
     // ============================================================
 
-    doc["ember_guardian_active"] = sys.emberGuardianActive;
+    doc["ember_guardian_active"] = t.guardianActive;
 
+    // Remaining time as of the snapshot, not as of serialization
     long remainingMs = 0;
-    if (sys.emberGuardianActive && sys.emberGuardianTimerMinutes > 0) {
-        unsigned long now = millis();
-        unsigned long total = (unsigned long)sys.emberGuardianTimerMinutes * 60000UL;
-        long elapsed = (long)(now - sys.emberGuardianStartMs);
+    if (t.guardianActive && t.guardianTimerMinutes > 0) {
+        unsigned long total = (unsigned long)t.guardianTimerMinutes * 60000UL;
+        long elapsed = (long)(t.takenMs - t.guardianStartMs);
         remainingMs = total - elapsed;
         if (remainingMs < 0) remainingMs = 0;
     }
@@ -241,16 +525,16 @@ static void mqtt_publishState() {
     doc["ember_guardian_remaining_text"] = gtxt;
 
     // Timing markers
-    doc["boost_start"] = sys.boostStartMs;
-    doc["ramp_start"]  = sys.rampStartMs;
-    doc["hold_start"]  = sys.holdStartMs;
-    doc["ember_start"] = sys.emberGuardianStartMs;
+    doc["boost_start"] = t.boostStartMs;
+    doc["ramp_start"]  = t.rampStartMs;
+    doc["hold_start"]  = t.holdStartMs;
+    doc["ember_start"] = t.guardianStartMs;
 
     // Boiler control
-    doc["control_mode"]       = sys.controlMode;
-    doc["safety_state"]       = sys.safetyState;
-    doc["tank_low_setpoint"]  = sys.tankLowSetpointF;
-    doc["tank_high_setpoint"] = sys.tankHighSetpointF;
+    doc["control_mode"]       = t.controlMode;
+    doc["safety_state"]       = t.safetyState;
+    doc["tank_low_setpoint"]  = t.tankLowSetpointF;
+    doc["tank_high_setpoint"] = t.tankHighSetpointF;
 
     char buf[1024];
     size_t n = serializeJson(doc, buf);
@@ -304,14 +588,14 @@ static void mqtt_publishSettings() {
     mqtt.endMessage();
 }
 
-static void mqtt_publishWater() {
+static void mqtt_publishWater(const TelemetrySnapshot& t) {
     StaticJsonDocument<256> doc;
 
     JsonArray arr = doc.createNestedArray("water");
-    for (uint8_t i = 0; i < sys.waterProbeCount; i++)
-        arr.add(sys.waterTempF[i]);
+    for (uint8_t i = 0; i < t.waterProbeCount; i++)
+        arr.add(t.waterTempF[i]);
 
-    doc["count"] = sys.waterProbeCount;
+    doc["count"] = t.waterProbeCount;
 
     char buf[256];
     size_t n = serializeJson(doc, buf);
@@ -321,12 +605,12 @@ static void mqtt_publishWater() {
     mqtt.endMessage();
 }
 
-static void mqtt_publishOutdoor() {
+static void mqtt_publishOutdoor(const TelemetrySnapshot& t) {
     StaticJsonDocument<256> doc;
 
-    doc["temp"] = sys.envTempF;
-    doc["hum"]  = sys.envHumidity;
-    doc["pres"] = sys.envPressure;
+    doc["temp"] = t.envTempF;
+    doc["hum"]  = t.envHumidity;
+    doc["pres"] = t.envPressure;
 
     char buf[256];
     size_t n = serializeJson(doc, buf);
@@ -336,551 +620,746 @@ static void mqtt_publishOutdoor() {
     mqtt.endMessage();
 }
 
-// ============================================================
-// HOME ASSISTANT DISCOVERY
-// ============================================================
+// Streamed straight into the socket: the sized beginMessage() sends the
+// header up front instead of buffering the payload.
+static void mqtt_publishPerf() {
+    uint32_t up = millis();
 
-static void publishDiscovery() {
+    mqtt.beginMessage(TOPIC_PERF, (unsigned long)perf_jsonLength(up));
+    perf_writeJson(mqtt, up);
+    mqtt.endMessage();
+}
 
-    publishDiscoverySensor("exhaust", "Exhaust Temp", TOPIC_STATE,
-                           "{{value_json.exhaust}}", "°F", "temperature", "mdi:fire");
+/*
+ * Offline backfill, oldest first, HISTORY_DRAIN_BATCH rows per message:
+ *   {"now":<uptime s>,"left":N,"lost":N,
+ *    "cols":["up","exh","tank","out","fan","burn","safety","guard"],
+ *    "rows":[[<uptime s when taken>,...],...]}
+ * Missing readings are null. Rows are dropped only after the
+ * message was handed to the socket.
+ */
+static void mqtt_publishHistory(unsigned long now) {
+    HistorySample batch[HISTORY_DRAIN_BATCH];
+    uint8_t n = history_peek(batch, HISTORY_DRAIN_BATCH);
+    if (n == 0) return;
+
+    static char buf[96 + HISTORY_DRAIN_BATCH * 48];
+    uint32_t nowMin = now / 60000UL;
+    size_t   len;
+
+    len = snprintf(buf, sizeof(buf),
+                   "{\"now\":%lu,\"left\":%u,\"lost\":%lu,"
+                   "\"cols\":[\"up\",\"exh\",\"tank\",\"out\",\"fan\",\"burn\",\"safety\",\"guard\"],"
+                   "\"rows\":[",
+                   (unsigned long)(now / 1000UL),
+                   (unsigned)(history_count() - n),
+                   (unsigned long)history_overflows());
+
+    for (uint8_t i = 0; i < n && len < sizeof(buf); i++) {
+        const HistorySample& h = batch[i];
+
+        // Samples are at most a few days old: undo the 16‑bit minute wrap
+        uint32_t upMin = nowMin - (uint16_t)((uint16_t)nowMin - h.minute);
+
+        char exh[8], tank[10], out[8];
+        if (h.exhaustF == HISTORY_NO_VALUE) strcpy(exh, "null");
+        else snprintf(exh, sizeof(exh), "%d", h.exhaustF);
+
+        int t10 = abs(h.tankF10);
+        if (h.tankF10 == HISTORY_NO_VALUE) strcpy(tank, "null");
+        else snprintf(tank, sizeof(tank), "%s%d.%d", h.tankF10 < 0 ? "-" : "", t10 / 10, t10 % 10);
+
+        if (h.outdoorF == 0xFF) strcpy(out, "null");
+        else snprintf(out, sizeof(out), "%d", (int)h.outdoorF - 64);
+
+        len += snprintf(buf + len, sizeof(buf) - len,
+                        "%s[%lu,%s,%s,%s,%u,%u,%u,%u]",
+                        i ? "," : "",
+                        (unsigned long)(upMin * 60UL), exh, tank, out,
+                        h.fan, HISTORY_FLAG_BURN(h.flags), HISTORY_FLAG_SAFETY(h.flags),
+                        (h.flags & HISTORY_FLAG_GUARDIAN) ? 1 : 0);
+    }
 
-    publishDiscoverySensor("fan", "Fan Speed", TOPIC_STATE,
-                           "{{value_json.fan}}", "%", nullptr, "mdi:fan");
+    if (len + 3 > sizeof(buf)) return;     // cannot happen with the sizes above
+    len += snprintf(buf + len, sizeof(buf) - len, "]}");
 
-    publishDiscoverySensor("fan_final", "Fan Final Output", TOPIC_STATE,
-                           "{{value_json.fan_final}}", "%", nullptr, "mdi:fan-speed-3");
+    mqtt.beginMessage(TOPIC_HISTORY, len, false);
+    mqtt.write((const uint8_t*)buf, len);
+    if (mqtt.endMessage()) history_drop(n);
+}
 
-    publishDiscoverySensor("wifi_signal", "WiFi Signal", TOPIC_STATE,
-                           "{{value_json.rssi}}", "dBm", "signal_strength", "mdi:wifi");
+// Current deadbands / heartbeats, retained so tools can read them back
+static void mqtt_publishTelemetryConfig() {
+    StaticJsonDocument<768> doc;
 
-    publishDiscoverySensor("burn_state", "Burn State", TOPIC_STATE,
-                           "{{value_json.state}}", "", nullptr, "mdi:fire-alert");
+    JsonObject db = doc.createNestedObject("deadbands");
+    for (uint8_t d = 0; d < DEADBAND_COUNT; d++) {
+        JsonObject e = db.createNestedObject(deadbands[d].key);
+        e["abs"] = deadbands[d].absBand;
+        e["rel"] = deadbands[d].relBand;
+    }
 
-    publishDiscoverySensor("state_text", "Burn Phase Text", TOPIC_STATE,
-                           "{{value_json.state_text}}", "", nullptr, "mdi:fire");
+    JsonObject tp = doc.createNestedObject("topics");
+    for (uint8_t i = 0; i < TT_COUNT; i++) {
+        JsonObject e = tp.createNestedObject(topics[i].key);
+        e["heartbeat_s"]    = topics[i].heartbeatMs / 1000UL;
+        e["min_interval_ms"] = topics[i].minIntervalMs;
+    }
 
-    // ============================================================
-    // Ember Guardian v3.3 — ONLY new fields
-    // ============================================================
+    char buf[768];
+    size_t n = serializeJson(doc, buf);
 
-    publishDiscoverySensor("ember_guardian_active", "Ember Guardian Active",
-                           TOPIC_STATE, "{{value_json.ember_guardian_active}}",
-                           "", "power", "mdi:shield");
+    mqtt.beginMessage(TOPIC_TELEMETRY_CFG, true);
+    mqtt.write((const uint8_t*)buf, n);
+    mqtt.endMessage();
+}
 
-    publishDiscoverySensor("ember_guardian_seconds", "Ember Guardian Seconds Remaining",
-                           TOPIC_STATE, "{{value_json.ember_guardian_seconds}}",
-                           "s", "duration", "mdi:timer-sand");
+// ============================================================
+// HOME ASSISTANT DISCOVERY
+// ------------------------------------------------------------
+// One const row per entity; a cursor publishes at most
+// HA_DISCOVERY_PER_TICK rows per mqtt_loop() pass so a reconnect
+// never stalls the scheduler while the WiFi module drains.
+//
+//   COLLECT  subscribed to our own retained configs for
+//            HA_DISCOVERY_COLLECT_MS; each one is hashed (FNV‑1a)
+//   PUBLISH  build row → hash → publish only if it differs from
+//            what the broker already holds
+//   DONE     unsubscribed; nothing left to do until reconnect
+// ============================================================
 
-    publishDiscoverySensor("ember_guardian_minutes", "Ember Guardian Minutes Remaining",
-                           TOPIC_STATE, "{{value_json.ember_guardian_minutes}}",
-                           "min", nullptr, "mdi:timer");
+enum HaKind : uint8_t { HA_SENSOR, HA_NUMBER, HA_SWITCH };
+
+struct HaEntity {
+    HaKind      kind;
+    const char* objectId;
+    const char* name;
+    const char* stateTopic;
+    const char* cmdTopic;        // number / switch
+    const char* valueTemplate;   // sensor
+    const char* unit;
+    const char* deviceClass;
+    const char* icon;
+    float       step;            // number; min/max come from commands[]
+};
+
+#define HA_S(id, name, stat, tpl, unit, cls, icon) \
+    { HA_SENSOR, id, name, stat, nullptr, tpl, unit, cls, icon, 0 }
+#define HA_N(id, name, cmd, stat, unit, step, cls, icon) \
+    { HA_NUMBER, id, name, stat, cmd, nullptr, unit, cls, icon, step }
+#define HA_W(id, name, cmd, stat, icon) \
+    { HA_SWITCH, id, name, stat, cmd, nullptr, nullptr, nullptr, icon, 0 }
+
+static const HaEntity haEntities[] = {
+    HA_S("exhaust",     "Exhaust Temp",     "boiler/state", "{{value_json.exhaust}}",    "°F",  "temperature",     "mdi:fire"),
+    HA_S("fan",         "Fan Speed",        "boiler/state", "{{value_json.fan}}",        "%",   nullptr,           "mdi:fan"),
+    HA_S("fan_final",   "Fan Final Output", "boiler/state", "{{value_json.fan_final}}",  "%",   nullptr,           "mdi:fan-speed-3"),
+    HA_S("wifi_signal", "WiFi Signal",      "boiler/state", "{{value_json.rssi}}",       "dBm", "signal_strength", "mdi:wifi"),
+    HA_S("burn_state",  "Burn State",       "boiler/state", "{{value_json.state}}",      "",    nullptr,           "mdi:fire-alert"),
+    HA_S("state_text",  "Burn Phase Text",  "boiler/state", "{{value_json.state_text}}", "",    nullptr,           "mdi:fire"),
+
+    // Ember Guardian v3.3
+    HA_S("ember_guardian_active",         "Ember Guardian Active",            "boiler/state",
+         "{{value_json.ember_guardian_active}}",         "",    "power",    "mdi:shield"),
+    HA_S("ember_guardian_seconds",        "Ember Guardian Seconds Remaining", "boiler/state",
+         "{{value_json.ember_guardian_seconds}}",        "s",   "duration", "mdi:timer-sand"),
+    HA_S("ember_guardian_minutes",        "Ember Guardian Minutes Remaining", "boiler/state",
+         "{{value_json.ember_guardian_minutes}}",        "min", nullptr,    "mdi:timer"),
+    HA_S("ember_guardian_remaining_text", "Ember Guardian Remaining Text",    "boiler/state",
+         "{{value_json.ember_guardian_remaining_text}}", "",    nullptr,    "mdi:timer-sand-complete"),
+    HA_W("ember_guardian_override", "Ember Guardian Override",
+         "boiler/cmd/ember_guardian_override", "boiler/state", "mdi:shield-off"),
 
-    publishDiscoverySensor("ember_guardian_remaining_text", "Ember Guardian Remaining Text",
-                           TOPIC_STATE, "{{value_json.ember_guardian_remaining_text}}",
-                           "", nullptr, "mdi:timer-sand-complete");
+    // Water probes
+    HA_S("water_1", "Water Temp 1", "boiler/water", "{{value_json.water[0]}}", "°F", "temperature", "mdi:coolant-temperature"),
+    HA_S("water_2", "Water Temp 2", "boiler/water", "{{value_json.water[1]}}", "°F", "temperature", "mdi:coolant-temperature"),
+    HA_S("water_3", "Water Temp 3", "boiler/water", "{{value_json.water[2]}}", "°F", "temperature", "mdi:coolant-temperature"),
+    HA_S("water_4", "Water Temp 4", "boiler/water", "{{value_json.water[3]}}", "°F", "temperature", "mdi:coolant-temperature"),
 
-    publishDiscoverySwitch("ember_guardian_override", "Ember Guardian Override",
-                           "boiler/cmd/ember_guardian_override",
-                           TOPIC_STATE, "mdi:shield-off");
+    // Outdoor BME280
+    HA_S("outdoor_temp", "Outdoor Temp",     "boiler/outdoor", "{{value_json.temp}}", "°F",  "temperature", "mdi:thermometer"),
+    HA_S("outdoor_hum",  "Outdoor Humidity", "boiler/outdoor", "{{value_json.hum}}",  "%",   "humidity",    "mdi:water-percent"),
+    HA_S("outdoor_pres", "Outdoor Pressure", "boiler/outdoor", "{{value_json.pres}}", "hPa", "pressure",    "mdi:gauge"),
 
-    // ============================================================
-    // Water probes
-    // ============================================================
+    // Controls
+    HA_N("setpoint",  "Exhaust Setpoint",        "boiler/cmd/setpoint",  "boiler/settings", "°F",  1, "temperature", "mdi:fire"),
+    HA_N("boost",     "Boost Time",              "boiler/cmd/boost",     "boiler/settings", "s",   5, nullptr, "mdi:rocket-launch"),
+    HA_N("deadband",  "Deadband",                "boiler/cmd/deadband",  "boiler/settings", "°F",  1, nullptr, "mdi:arrow-expand-vertical"),
+    HA_N("clamp_min", "Fan Clamp Min",           "boiler/cmd/clamp_min", "boiler/settings", "%",   1, nullptr, "mdi:fan"),
+    HA_N("clamp_max", "Fan Clamp Max",           "boiler/cmd/clamp_max", "boiler/settings", "%",   1, nullptr, "mdi:fan"),
+    HA_W("deadzone",  "Deadzone Fan Mode",       "boiler/cmd/deadzone",  "boiler/settings", "mdi:toggle-switch"),
+    HA_N("ember",     "Ember Guardian Minutes",  "boiler/cmd/ember",     "boiler/settings", "min", 1, nullptr, "mdi:shield"),
+    HA_N("flue_low",  "Flue Low Threshold",      "boiler/cmd/flue_low",  "boiler/settings", "°F",  5, nullptr, "mdi:thermometer-alert"),
+    HA_N("flue_rec",  "Flue Recovery Threshold", "boiler/cmd/flue_rec",  "boiler/settings", "°F",  5, nullptr, "mdi:thermometer-chevron-up"),
+    HA_N("lockout",   "Season Lockout Hours",    "boiler/cmd/lockout",   "boiler/settings", "h",   1, nullptr, "mdi:timer-lock"),
+    HA_W("auto_season", "Auto Season",           "boiler/cmd/auto_season", "boiler/settings", "mdi:calendar-sync"),
+    HA_N("season_mode", "Season Mode",           "boiler/cmd/season_mode", "boiler/settings", "",    1, nullptr, "mdi:calendar"),
+
+    HA_N("summer_setpoint",  "Summer Setpoint",      "boiler/cmd/summer_setpoint",  "boiler/settings", "°F",  1, nullptr, nullptr),
+    HA_N("spf_setpoint",     "Spring/Fall Setpoint", "boiler/cmd/spf_setpoint",     "boiler/settings", "°F",  1, nullptr, nullptr),
+    HA_N("winter_setpoint",  "Winter Setpoint",      "boiler/cmd/winter_setpoint",  "boiler/settings", "°F",  1, nullptr, nullptr),
+    HA_N("extreme_setpoint", "Extreme Setpoint",     "boiler/cmd/extreme_setpoint", "boiler/settings", "°F",  1, nullptr, nullptr),
+
+    // v3.0 Boiler Control
+    HA_N("tank_low",     "Tank Low Setpoint",  "boiler/cmd/tank_low",     "boiler/settings", "°F",  1, nullptr, "mdi:water-boiler"),
+    HA_N("tank_high",    "Tank High Setpoint", "boiler/cmd/tank_high",    "boiler/settings", "°F",  1, nullptr, "mdi:water-boiler"),
+    HA_N("control_mode", "Control Mode",       "boiler/cmd/control_mode", "boiler/settings", "",    1, nullptr, "mdi:toggle-switch"),
+};
+
+#undef HA_S
+#undef HA_N
+#undef HA_W
+
+static const uint8_t HA_ENTITY_COUNT = sizeof(haEntities) / sizeof(haEntities[0]);
+
+enum DiscoveryState : uint8_t { DISCO_IDLE, DISCO_COLLECT, DISCO_PUBLISH, DISCO_DONE };
+
+static DiscoveryState discoState   = DISCO_IDLE;
+static unsigned long  discoStartMs = 0;
+static uint8_t        discoCursor  = 0;
+static uint8_t        discoSent    = 0;
+static uint8_t        discoSkipped = 0;
+
+// Hash of the retained config the broker holds (0 = none seen)
+static uint32_t       discoHash[HA_ENTITY_COUNT];
+
+static const char* const haKindName[] = { "sensor", "number", "switch" };
+
+static char discoSubTopic[64];
+
+/* ---------------- hashing ---------------- */
+
+static uint32_t fnv1a(uint32_t h, uint8_t b) {
+    return (h ^ b) * 16777619UL;
+}
 
-    for (int i = 0; i < 4; i++) {
-        char obj[16], name[32], tpl[64];
-        snprintf(obj, sizeof(obj), "water_%d", i + 1);
-        snprintf(name, sizeof(name), "Water Temp %d", i + 1);
-        snprintf(tpl, sizeof(tpl), "{{value_json.water[%d]}}", i);
+static uint32_t fnv1aBuf(const char* p, size_t n) {
+    uint32_t h = 2166136261UL;
+    while (n--) h = fnv1a(h, (uint8_t)*p++);
+    return h ? h : 1;
+}
 
-        publishDiscoverySensor(obj, name, TOPIC_WATER,
-                               tpl, "°F", "temperature", "mdi:coolant-temperature");
-    }
+/* ---------------- config builder ---------------- */
 
-    // ============================================================
-    // Outdoor BME280
-    // ============================================================
+// Accepted range of a boiler/cmd/<name> topic (defined with commands[])
+static bool commandRange(const char* cmdTopic, int32_t& lo, int32_t& hi);
 
-    publishDiscoverySensor("outdoor_temp", "Outdoor Temp", TOPIC_OUTDOOR,
-                           "{{value_json.temp}}", "°F", "temperature", "mdi:thermometer");
+static size_t buildDiscovery(const HaEntity& e, char* topic, size_t topicLen,
+                             char* out, size_t outLen) {
+    static StaticJsonDocument<512> doc;
+    char uniq[48];
 
-    publishDiscoverySensor("outdoor_hum", "Outdoor Humidity", TOPIC_OUTDOOR,
-                           "{{value_json.hum}}", "%", "humidity", "mdi:water-percent");
+    snprintf(topic, topicLen, "%s/%s/%s/%s/config",
+             HA_DISCOVERY_PREFIX, haKindName[e.kind], HA_DEVICE_ID, e.objectId);
+    snprintf(uniq, sizeof(uniq), "%s_%s", HA_DEVICE_ID, e.objectId);
 
-    publishDiscoverySensor("outdoor_pres", "Outdoor Pressure", TOPIC_OUTDOOR,
-                           "{{value_json.pres}}", "hPa", "pressure", "mdi:gauge");
+    doc.clear();
 
-    // ============================================================
-    // Controls
-    // ============================================================
+    doc["name"]    = e.name;
+    doc["uniq_id"] = (const char*)uniq;   // copied into the document
 
-    publishDiscoveryNumber("setpoint", "Exhaust Setpoint",
-                           "boiler/cmd/setpoint", TOPIC_SETTINGS,
-                           "°F", 200, 900, 1, "temperature", "mdi:fire");
+    if (e.cmdTopic) doc["cmd_t"] = e.cmdTopic;
+    doc["stat_t"] = e.stateTopic;
 
-    publishDiscoveryNumber("boost", "Boost Time",
-                           "boiler/cmd/boost", TOPIC_SETTINGS,
-                           "s", 5, 300, 5, nullptr, "mdi:rocket-launch");
+    if (e.kind == HA_SENSOR && e.valueTemplate) doc["val_tpl"] = e.valueTemplate;
 
-    publishDiscoveryNumber("deadband", "Deadband",
-                           "boiler/cmd/deadband", TOPIC_SETTINGS,
-                           "°F", 1, 100, 1, nullptr, "mdi:arrow-expand-vertical");
+    if (e.kind == HA_NUMBER) {
+        int32_t lo, hi;
+        if (commandRange(e.cmdTopic, lo, hi)) {
+            doc["min"] = lo;
+            doc["max"] = hi;
+        }
+        doc["step"] = e.step;
+    }
 
-    publishDiscoveryNumber("clamp_min", "Fan Clamp Min",
-                           "boiler/cmd/clamp_min", TOPIC_SETTINGS,
-                           "%", 0, 100, 1, nullptr, "mdi:fan");
+    if (e.unit)        doc["unit_of_meas"] = e.unit;
+    if (e.deviceClass) doc["dev_cla"]      = e.deviceClass;
+    if (e.icon)        doc["ic"]           = e.icon;
 
-    publishDiscoveryNumber("clamp_max", "Fan Clamp Max",
-                           "boiler/cmd/clamp_max", TOPIC_SETTINGS,
-                           "%", 0, 100, 1, nullptr, "mdi:fan");
+    JsonObject dev = doc.createNestedObject("dev");
+    dev["ids"]  = HA_DEVICE_ID;
+    dev["name"] = HA_DEVICE_NAME;
+    dev["mf"]   = HA_DEVICE_MFR;
+    dev["mdl"]  = HA_DEVICE_MODEL;
+    dev["sw"]   = HA_DEVICE_SW;
 
-    publishDiscoverySwitch("deadzone", "Deadzone Fan Mode",
-                           "boiler/cmd/deadzone", TOPIC_SETTINGS,
-                           "mdi:toggle-switch");
+    return serializeJson(doc, out, outLen);
+}
 
-    publishDiscoveryNumber("ember", "Ember Guardian Minutes",
-                           "boiler/cmd/ember", TOPIC_SETTINGS,
-                           "min", 5, 60, 1, nullptr, "mdi:shield");
+/* ---------------- state machine ---------------- */
 
-    publishDiscoveryNumber("flue_low", "Flue Low Threshold",
-                           "boiler/cmd/flue_low", TOPIC_SETTINGS,
-                           "°F", 50, 900, 5, nullptr, "mdi:thermometer-alert");
+// Fresh session: learn what the broker retains, then walk the table
+static void discovery_begin(unsigned long now) {
+    memset(discoHash, 0, sizeof(discoHash));
+    discoCursor  = 0;
+    discoSent    = 0;
+    discoSkipped = 0;
+    discoStartMs = now;
 
-    publishDiscoveryNumber("flue_rec", "Flue Recovery Threshold",
-                           "boiler/cmd/flue_rec", TOPIC_SETTINGS,
-                           "°F", 50, 900, 5, nullptr, "mdi:thermometer-chevron-up");
+    snprintf(discoSubTopic, sizeof(discoSubTopic), "%s/+/%s/+/config",
+             HA_DISCOVERY_PREFIX, HA_DEVICE_ID);
+    mqtt.subscribe(discoSubTopic);
 
-    publishDiscoveryNumber("lockout", "Season Lockout Hours",
-                           "boiler/cmd/lockout", TOPIC_SETTINGS,
-                           "h", 1, 24, 1, nullptr, "mdi:timer-lock");
+    discoState = DISCO_COLLECT;
+}
 
-    publishDiscoverySwitch("auto_season", "Auto Season",
-                           "boiler/cmd/auto_season", TOPIC_SETTINGS,
-                           "mdi:calendar-sync");
+static void discovery_step(unsigned long now) {
+    if (discoState == DISCO_COLLECT) {
+        if (now - discoStartMs < HA_DISCOVERY_COLLECT_MS) return;
 
-    publishDiscoveryNumber("season_mode", "Season Mode",
-                           "boiler/cmd/season_mode", TOPIC_SETTINGS,
-                           "", 0, 2, 1, nullptr, "mdi:calendar");
+        mqtt.unsubscribe(discoSubTopic);
+        discoState = DISCO_PUBLISH;
+    }
 
-    publishDiscoveryNumber("summer_setpoint", "Summer Setpoint",
-                           "boiler/cmd/summer_setpoint", TOPIC_SETTINGS,
-                           "°F", 200, 900, 1);
+    if (discoState != DISCO_PUBLISH) return;
 
-    publishDiscoveryNumber("spf_setpoint", "Spring/Fall Setpoint",
-                           "boiler/cmd/spf_setpoint", TOPIC_SETTINGS,
-                           "°F", 200, 900, 1);
+    static char topic[128];
+    static char buf[512];
 
-    publishDiscoveryNumber("winter_setpoint", "Winter Setpoint",
-                           "boiler/cmd/winter_setpoint", TOPIC_SETTINGS,
-                           "°F", 200, 900, 1);
+    for (uint8_t n = 0; n < HA_DISCOVERY_PER_TICK && discoCursor < HA_ENTITY_COUNT; ) {
+        size_t len = buildDiscovery(haEntities[discoCursor], topic, sizeof(topic),
+                                    buf, sizeof(buf));
+        uint32_t h = fnv1aBuf(buf, len);
 
-    publishDiscoveryNumber("extreme_setpoint", "Extreme Setpoint",
-                           "boiler/cmd/extreme_setpoint", TOPIC_SETTINGS,
-                           "°F", 200, 900, 1);
+        if (h == discoHash[discoCursor]) {
+            discoSkipped++;                 // broker already retains this exact config
+        } else {
+            mqtt.beginMessage(topic, len, true);
+            mqtt.write((const uint8_t*)buf, len);
+            mqtt.endMessage();
 
-    // v3.0 Boiler Control discovery
-    publishDiscoveryNumber("tank_low", "Tank Low Setpoint",
-                           "boiler/cmd/tank_low", TOPIC_SETTINGS,
-                           "°F", 80, 190, 1, nullptr, "mdi:water-boiler");
+            discoHash[discoCursor] = h;
+            discoSent++;
+            n++;                            // only real publishes use the tick budget
+        }
+        discoCursor++;
+    }
 
-    publishDiscoveryNumber("tank_high", "Tank High Setpoint",
-                           "boiler/cmd/tank_high", TOPIC_SETTINGS,
-                           "°F", 80, 190, 1, nullptr, "mdi:water-boiler");
+    if (discoCursor >= HA_ENTITY_COUNT) {
+        discoState = DISCO_DONE;
 
-    publishDiscoveryNumber("control_mode", "Control Mode",
-                           "boiler/cmd/control_mode", TOPIC_SETTINGS,
-                           "", 0, 1, 1, nullptr, "mdi:toggle-switch");
+        Serial.print("MQTT: discovery done, sent ");
+        Serial.print(discoSent);
+        Serial.print(", unchanged ");
+        Serial.println(discoSkipped);
+    }
 }
 
-/* ============================================================
- *  DISCOVERY HELPERS
- * ============================================================ */
-
-static void publishDiscoverySensor(
-    const char* objectId,
-    const char* name,
-    const char* stateTopic,
-    const char* valueTemplate,
-    const char* unit,
-    const char* deviceClass,
-    const char* icon
-) {
-    char topic[128];
-    snprintf(topic, sizeof(topic),
-             "%s/sensor/%s/%s/config",
-             HA_DISCOVERY_PREFIX, HA_DEVICE_ID, objectId);
-
-    StaticJsonDocument<512> doc;
-
-    doc["name"]    = name;
-    doc["uniq_id"] = String(HA_DEVICE_ID) + "_" + objectId;
-    doc["stat_t"]  = stateTopic;
-
-    if (valueTemplate) doc["val_tpl"] = valueTemplate;
-    if (unit)         doc["unit_of_meas"] = unit;
-    if (deviceClass)  doc["dev_cla"] = deviceClass;
-    if (icon)         doc["ic"] = icon;
+// Retained config echoed back while collecting. Returns true if consumed.
+static bool discovery_onRetained(const String& topic, int messageSize) {
+    if (!topic.startsWith(HA_DISCOVERY_PREFIX)) return false;
 
-    JsonObject dev = doc.createNestedObject("dev");
-    dev["ids"]  = HA_DEVICE_ID;
-    dev["name"] = HA_DEVICE_NAME;
-    dev["mf"]   = HA_DEVICE_MFR;
-    dev["mdl"]  = HA_DEVICE_MODEL;
-    dev["sw"]   = HA_DEVICE_SW;
+    if (discoState == DISCO_COLLECT) {
+        // homeassistant/<kind>/<device>/<objectId>/config
+        const char* t     = topic.c_str();
+        const char* end   = strrchr(t, '/');
+        const char* start = end;
+        while (start && start > t && start[-1] != '/') start--;
 
-    char buf[512];
-    serializeJson(doc, buf);
+        uint32_t h = 2166136261UL;
+        for (int i = 0; i < messageSize && mqtt.available(); i++) {
+            h = fnv1a(h, (uint8_t)mqtt.read());
+        }
+        if (!h) h = 1;
+
+        for (uint8_t i = 0; start && i < HA_ENTITY_COUNT; i++) {
+            const char* id = haEntities[i].objectId;
+            size_t len = (size_t)(end - start);
+            if (strlen(id) == len && strncmp(start, id, len) == 0) {
+                discoHash[i] = (messageSize > 0) ? h : 0;
+                break;
+            }
+        }
+    }
 
-    mqtt.beginMessage(topic, true);
-    mqtt.print(buf);
-    mqtt.endMessage();
+    while (mqtt.available()) mqtt.read();   // drain anything left
+    return true;
 }
 
-static void publishDiscoveryNumber(
-    const char* objectId,
-    const char* name,
-    const char* cmdTopic,
-    const char* stateTopic,
-    const char* unit,
-    float minVal,
-    float maxVal,
-    float step,
-    const char* deviceClass,
-    const char* icon
-) {
-    char topic[128];
-    snprintf(topic, sizeof(topic),
-             "%s/number/%s/%s/config",
-             HA_DISCOVERY_PREFIX, HA_DEVICE_ID, objectId);
-
-    StaticJsonDocument<512> doc;
-
-    doc["name"]    = name;
-    doc["uniq_id"] = String(HA_DEVICE_ID) + "_" + objectId;
-    doc["cmd_t"]   = cmdTopic;
-    doc["stat_t"]  = stateTopic;
-
-    doc["min"]  = minVal;
-    doc["max"]  = maxVal;
-    doc["step"] = step;
-
-    if (unit)        doc["unit_of_meas"] = unit;
-    if (deviceClass) doc["dev_cla"]      = deviceClass;
-    if (icon)        doc["ic"]           = icon;
-
-    JsonObject dev = doc.createNestedObject("dev");
-    dev["ids"]  = HA_DEVICE_ID;
-    dev["name"] = HA_DEVICE_NAME;
-    dev["mf"]   = HA_DEVICE_MFR;
-    dev["mdl"]  = HA_DEVICE_MODEL;
-    dev["sw"]   = HA_DEVICE_SW;
+static bool discovery_done() {
+    return discoState == DISCO_DONE;
+}
 
-    char buf[512];
-    serializeJson(doc, buf);
+static void discovery_status(JsonObject out) {
+    static const char* const text[] = { "idle", "collect", "publish", "done" };
 
-    mqtt.beginMessage(topic, true);
-    mqtt.print(buf);
-    mqtt.endMessage();
+    out["status"]    = text[discoState];
+    out["done"]      = discoCursor;
+    out["total"]     = HA_ENTITY_COUNT;
+    out["sent"]      = discoSent;
+    out["unchanged"] = discoSkipped;
 }
 
-static void publishDiscoverySwitch(
-    const char* objectId,
-    const char* name,
-    const char* cmdTopic,
-    const char* stateTopic,
-    const char* icon
-) {
-    char topic[128];
-    snprintf(topic, sizeof(topic),
-             "%s/switch/%s/%s/config",
-             HA_DISCOVERY_PREFIX, HA_DEVICE_ID, objectId);
+/* ============================================================
+ *  COMMAND TABLE
+ *  ------------------------------------------------------------
+ *  boiler/cmd/<name>, payload {"value":x}, a bare number, or
+ *  ON/OFF (what Home Assistant number/switch entities send).
+ *
+ *  FIELD rows are range‑checked against min/max *before* any
+ *  write, applied through the SystemFields setter (field =
+ *  value × scale) and persisted only when the value changed.
+ *  CUSTOM rows run a handler. Every command is answered on
+ *  boiler/ack/<name>:
+ *      {"ok":true,"value":<applied>}
+ *      {"ok":false,"error":"range","min":..,"max":..}
+ *
+ *  Rows MUST stay sorted by name (strcmp): lookup is a binary
+ *  search, checked once in mqtt_init().
+ * ============================================================ */
 
-    StaticJsonDocument<512> doc;
+enum CmdKind : uint8_t { CMD_FIELD, CMD_CUSTOM };
+
+typedef bool (*CmdHandler)(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err);
+
+struct MqttCommand {
+    const char* name;
+    CmdKind     kind;
+    SysField    field;
+    int32_t     minVal;
+    int32_t     maxVal;
+    int32_t     scale;                  // field value = command value × scale
+    void      (*save)(int32_t v);       // EEPROM policy; nullptr = RAM only
+    CmdHandler  custom;
+};
+
+static bool cmdGuardianOverride(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err);
+static bool cmdFactoryReset(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err);
+static bool cmdProbeRole(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err);
+static bool cmdTelemetry(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err);
+
+#define CMD_F(name, id, lo, hi, scale, save) \
+    { name, CMD_FIELD, SF_##id, lo, hi, scale, save, nullptr }
+#define CMD_C(name, handler) \
+    { name, CMD_CUSTOM, SF_COUNT, 0, 0, 1, nullptr, handler }
+
+#define SAVE_VALUE(fn)  [](int32_t v) { fn(v); }
+#define SAVE_GROUP(fn)  [](int32_t)   { fn(); }
+
+static const MqttCommand commands[] = {
+    CMD_F("auto_season",      AUTO_SEASON,        0,   1,    1, SAVE_VALUE(eeprom_saveEnvAutoSeason)),
+    CMD_F("boost",            BOOST_TIME,         5, 600,    1, SAVE_VALUE(eeprom_saveBoostTime)),
+    CMD_F("clamp_max",        CLAMP_MAX,          0, 100,    1, SAVE_VALUE(eeprom_saveClampMax)),
+    CMD_F("clamp_min",        CLAMP_MIN,          0, 100,    1, SAVE_VALUE(eeprom_saveClampMin)),
+    CMD_F("control_mode",     CONTROL_MODE,       0,   1,    1, SAVE_VALUE(eeprom_saveRunMode)),
+    CMD_F("deadband",         DEADBAND,           1, 100,    1, SAVE_VALUE(eeprom_saveDeadband)),
+    CMD_F("deadzone",         DEADZONE_MODE,      0,   1,    1, SAVE_VALUE(eeprom_saveDeadzone)),
+    CMD_F("ember",            GUARDIAN_MINUTES,   1, 120,    1, SAVE_VALUE(eeprom_saveEmberGuardianMinutes)),
+    CMD_C("ember_guardian_override", cmdGuardianOverride),
+    CMD_F("extreme_buffer",   EXTREME_BUFFER,     0,  50,    1, SAVE_GROUP(eeprom_saveEnvSeasonHyst)),
+    CMD_F("extreme_setpoint", EXTREME_SETPOINT, 200, 900,    1, SAVE_GROUP(eeprom_saveEnvSeasonSetpoints)),
+    CMD_F("extreme_start",    EXTREME_START,    -50, 120,    1, SAVE_GROUP(eeprom_saveEnvSeasonStarts)),
+    CMD_C("factory_reset",    cmdFactoryReset),
+    CMD_F("flue_low",         FLUE_LOW,          50, 500,    1, SAVE_VALUE(eeprom_saveFlueLow)),
+    CMD_F("flue_rec",         FLUE_RECOVERY,     50, 500,    1, SAVE_VALUE(eeprom_saveFlueRecovery)),
+    CMD_F("lockout",          LOCKOUT_SEC,        1,  24, 3600, SAVE_VALUE(eeprom_saveEnvLockoutHours)),
+    CMD_C("probe_role",       cmdProbeRole),
+    CMD_F("season_mode",      SEASON_MODE,        0,   2,    1, SAVE_VALUE(eeprom_saveEnvSeasonMode)),
+    CMD_F("setpoint",         EXHAUST_SETPOINT, 200, 900,    1, SAVE_VALUE(eeprom_saveSetpoint)),
+    CMD_F("spf_buffer",       SPF_BUFFER,         0,  50,    1, SAVE_GROUP(eeprom_saveEnvSeasonHyst)),
+    CMD_F("spf_setpoint",     SPF_SETPOINT,     200, 900,    1, SAVE_GROUP(eeprom_saveEnvSeasonSetpoints)),
+    CMD_F("spf_start",        SPF_START,        -50, 120,    1, SAVE_GROUP(eeprom_saveEnvSeasonStarts)),
+    CMD_F("summer_buffer",    SUMMER_BUFFER,      0,  50,    1, SAVE_GROUP(eeprom_saveEnvSeasonHyst)),
+    CMD_F("summer_setpoint",  SUMMER_SETPOINT,  200, 900,    1, SAVE_GROUP(eeprom_saveEnvSeasonSetpoints)),
+    CMD_F("summer_start",     SUMMER_START,     -50, 120,    1, SAVE_GROUP(eeprom_saveEnvSeasonStarts)),
+    CMD_F("tank_high",        TANK_HIGH,         80, 210,    1, SAVE_VALUE(eeprom_saveTankHigh)),
+    CMD_F("tank_low",         TANK_LOW,          60, 200,    1, SAVE_VALUE(eeprom_saveTankLow)),
+    CMD_C("telemetry",        cmdTelemetry),
+    CMD_F("winter_buffer",    WINTER_BUFFER,      0,  50,    1, SAVE_GROUP(eeprom_saveEnvSeasonHyst)),
+    CMD_F("winter_setpoint",  WINTER_SETPOINT,  200, 900,    1, SAVE_GROUP(eeprom_saveEnvSeasonSetpoints)),
+    CMD_F("winter_start",     WINTER_START,     -50, 120,    1, SAVE_GROUP(eeprom_saveEnvSeasonStarts)),
+};
+
+#undef CMD_F
+#undef CMD_C
+#undef SAVE_VALUE
+#undef SAVE_GROUP
+
+static const uint8_t COMMAND_COUNT = sizeof(commands) / sizeof(commands[0]);
+
+static const char* CMD_PREFIX     = "boiler/cmd/";
+static const size_t CMD_PREFIX_LEN = 11;
+
+static bool factoryResetRequested = false;
+
+static const MqttCommand* findCommand(const char* name) {
+    int lo = 0, hi = COMMAND_COUNT - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int c = strcmp(name, commands[mid].name);
+        if (c == 0) return &commands[mid];
+        if (c < 0) hi = mid - 1;
+        else       lo = mid + 1;
+    }
+    return nullptr;
+}
 
-    doc["name"]    = name;
-    doc["uniq_id"] = String(HA_DEVICE_ID) + "_" + objectId;
-    doc["cmd_t"]   = cmdTopic;
-    doc["stat_t"]  = stateTopic;
+static bool commandRange(const char* cmdTopic, int32_t& lo, int32_t& hi) {
+    if (strncmp(cmdTopic, CMD_PREFIX, CMD_PREFIX_LEN) != 0) return false;
 
-    if (icon) doc["ic"] = icon;
+    const MqttCommand* cmd = findCommand(cmdTopic + CMD_PREFIX_LEN);
+    if (!cmd || cmd->kind != CMD_FIELD) return false;
 
-    JsonObject dev = doc.createNestedObject("dev");
-    dev["ids"]  = HA_DEVICE_ID;
-    dev["name"] = HA_DEVICE_NAME;
-    dev["mf"]   = HA_DEVICE_MFR;
-    dev["mdl"]  = HA_DEVICE_MODEL;
-    dev["sw"]   = HA_DEVICE_SW;
+    lo = cmd->minVal;
+    hi = cmd->maxVal;
+    return true;
+}
 
-    char buf[512];
-    serializeJson(doc, buf);
+static void checkCommandTable() {
+    for (uint8_t i = 1; i < COMMAND_COUNT; i++) {
+        if (strcmp(commands[i - 1].name, commands[i].name) >= 0) {
+            Serial.print("MQTT: command table not sorted at ");
+            Serial.println(commands[i].name);
+        }
+    }
 
-    mqtt.beginMessage(topic, true);
-    mqtt.print(buf);
-    mqtt.endMessage();
+    // Discovery min/max are taken from here; every number needs a row
+    int32_t lo, hi;
+    for (uint8_t i = 0; i < HA_ENTITY_COUNT; i++) {
+        if (haEntities[i].kind == HA_NUMBER &&
+            !commandRange(haEntities[i].cmdTopic, lo, hi)) {
+            Serial.print("MQTT: no command range for ");
+            Serial.println(haEntities[i].objectId);
+        }
+    }
 }
 
 /* ============================================================
- *  COMMAND HANDLER
+ *  PAYLOAD PARSING
  * ============================================================ */
 
-static void mqtt_onMessage(int messageSize) {
-    String topic = mqtt.messageTopic();
+// "ON"/"OFF"/"true"/"false" or an integer (rounded if fractional)
+static bool parseScalar(const char* txt, int32_t& out) {
+    if (!strcasecmp(txt, "on")  || !strcasecmp(txt, "true"))  { out = 1; return true; }
+    if (!strcasecmp(txt, "off") || !strcasecmp(txt, "false")) { out = 0; return true; }
 
-    StaticJsonDocument<256> doc;
-    if (deserializeJson(doc, mqtt)) {
-        return;
-    }
+    char* end;
+    double v = strtod(txt, &end);
+    if (end == txt) return false;
+    while (*end == ' ' || *end == '\r' || *end == '\n') end++;
+    if (*end) return false;
+
+    out = (int32_t)lround(v);
+    return true;
+}
 
-    handleCommandTopic(topic, doc);
+static bool commandValue(JsonVariant v, int32_t& out) {
+    if (v.isNull()) return false;
+    if (v.is<bool>())        { out = v.as<bool>() ? 1 : 0; return true; }
+    if (v.is<const char*>()) return parseScalar(v.as<const char*>(), out);
+    if (v.is<float>())       { out = (int32_t)lroundf(v.as<float>()); return true; }
+    return false;
 }
 
 /* ============================================================
- *  TOPIC DISPATCHER
+ *  ACK / NACK
  * ============================================================ */
 
-static void handleCommandTopic(const String& topic, StaticJsonDocument<256>& doc) {
+static void publishAck(const char* name, bool ok, int32_t value,
+                       const char* err, const MqttCommand* cmd) {
+    char topic[64];
+    char buf[96];
+    int  n;
 
-    if (!doc.containsKey("value")) return;
-    auto val = doc["value"];
+    snprintf(topic, sizeof(topic), "boiler/ack/%s", name);
 
-    // ---------------- CORE SETTINGS ----------------
+    if (ok)
+        n = snprintf(buf, sizeof(buf), "{\"ok\":true,\"value\":%ld}", (long)value);
+    else if (cmd && cmd->kind == CMD_FIELD)
+        n = snprintf(buf, sizeof(buf), "{\"ok\":false,\"error\":\"%s\",\"min\":%ld,\"max\":%ld}",
+                     err, (long)cmd->minVal, (long)cmd->maxVal);
+    else
+        n = snprintf(buf, sizeof(buf), "{\"ok\":false,\"error\":\"%s\"}", err);
 
-    if (topic.endsWith("/setpoint")) {
-        int v = val.as<int>();
-        eeprom_saveSetpoint(v);
-        sys.exhaustSetpoint = v;
-        return;
-    }
+    if (n < 0 || n >= (int)sizeof(buf)) return;
 
-    if (topic.endsWith("/boost")) {
-        int v = val.as<int>();
-        eeprom_saveBoostTime(v);
-        sys.boostTimeSeconds = v;
-        return;
-    }
+    mqtt.beginMessage(topic, (unsigned long)n, false);
+    mqtt.write((const uint8_t*)buf, n);
+    mqtt.endMessage();
+}
 
-    if (topic.endsWith("/deadband")) {
-        int v = val.as<int>();
-        eeprom_saveDeadband(v);
-        sys.deadbandF = v;
-        return;
-    }
+/* ============================================================
+ *  COMMAND HANDLER
+ * ============================================================ */
 
-    if (topic.endsWith("/clamp_min")) {
-        int v = val.as<int>();
-        eeprom_saveClampMin(v);
-        sys.clampMinPercent = v;
-        return;
-    }
+static void mqtt_onMessage(int messageSize) {
+    String topic = mqtt.messageTopic();
 
-    if (topic.endsWith("/clamp_max")) {
-        int v = val.as<int>();
-        eeprom_saveClampMax(v);
-        sys.clampMaxPercent = v;
-        return;
-    }
+    if (discovery_onRetained(topic, messageSize)) return;
 
-    if (topic.endsWith("/deadzone")) {
-        bool v = val.as<bool>();
-        eeprom_saveDeadzone(v ? 1 : 0);
-        sys.deadzoneFanMode = v ? 1 : 0;
+    if (!topic.startsWith(CMD_PREFIX)) {
+        while (mqtt.available()) mqtt.read();
         return;
     }
 
-    if (topic.endsWith("/ember")) {
-        int v = val.as<int>();
-        eeprom_saveEmberGuardianMinutes(v);
-        sys.emberGuardianTimerMinutes = v;
-        return;
-    }
+    const char* name = topic.c_str() + CMD_PREFIX_LEN;
 
-    if (topic.endsWith("/flue_low")) {
-        int v = val.as<int>();
-        eeprom_saveFlueLow(v);
-        sys.flueLowThreshold = v;
-        return;
+    // Bounded read: anything longer than the buffer is rejected
+    char raw[192];
+    int  len = 0;
+    while (mqtt.available()) {
+        int c = mqtt.read();
+        if (len < (int)sizeof(raw) - 1) raw[len] = (char)c;
+        len++;
     }
-
-    if (topic.endsWith("/flue_rec")) {
-        int v = val.as<int>();
-        eeprom_saveFlueRecovery(v);
-        sys.flueRecoveryThreshold = v;
+    if (len >= (int)sizeof(raw)) {
+        publishAck(name, false, 0, "too_long", findCommand(name));
         return;
     }
+    raw[len] = 0;
 
-    // ---------------- SEASONAL LOGIC ----------------
-
-    if (topic.endsWith("/season_mode")) {
-        int mode = val.as<int>();
-        eeprom_saveEnvSeasonMode(mode);
-        sys.envSeasonMode = mode;
-        return;
+    StaticJsonDocument<256> doc;
+    if (deserializeJson(doc, raw, len) || !doc.is<JsonObject>()) {
+        // Bare value (Home Assistant number/switch): wrap it
+        int32_t v;
+        bool    ok = parseScalar(raw, v);
+        doc.clear();
+        if (ok) doc["value"] = v;
     }
 
-    if (topic.endsWith("/auto_season")) {
-        bool en = val.as<bool>();
-        eeprom_saveEnvAutoSeason(en);
-        sys.envAutoSeasonEnabled = en;
-        return;
-    }
+    handleCommand(name, doc);
 
-    if (topic.endsWith("/lockout")) {
-        int hr = val.as<int>();
-        eeprom_saveEnvLockoutHours(hr);
-        sys.envModeLockoutSec = (uint32_t)hr * 3600UL;
-        return;
+    if (factoryResetRequested) {
+        factoryResetRequested = false;
+        wifi_prov_factoryReset();
     }
+}
 
-    if (topic.endsWith("/summer_start")) {
-        int v = val.as<int>();
-        sys.envSummerStartF = v;
-        eeprom_saveEnvSeasonStarts();
+static void handleCommand(const char* name, StaticJsonDocument<256>& doc) {
+    const MqttCommand* cmd = findCommand(name);
+    if (!cmd) {
+        publishAck(name, false, 0, "unknown", nullptr);
         return;
     }
 
-    if (topic.endsWith("/spf_start")) {
-        int v = val.as<int>();
-        sys.envSpringFallStartF = v;
-        eeprom_saveEnvSeasonStarts();
-        return;
-    }
+    int32_t     applied = 0;
+    const char* err     = "invalid";
 
-    if (topic.endsWith("/winter_start")) {
-        int v = val.as<int>();
-        sys.envWinterStartF = v;
-        eeprom_saveEnvSeasonStarts();
+    if (cmd->kind == CMD_CUSTOM) {
+        bool ok = cmd->custom(doc, applied, err);
+        publishAck(name, ok, applied, err, cmd);
         return;
     }
 
-    if (topic.endsWith("/extreme_start")) {
-        int v = val.as<int>();
-        sys.envExtremeStartF = v;
-        eeprom_saveEnvSeasonStarts();
+    int32_t v;
+    if (!commandValue(doc["value"], v)) {
+        publishAck(name, false, 0, "value", cmd);
         return;
     }
-
-    if (topic.endsWith("/summer_buffer")) {
-        int v = val.as<int>();
-        sys.envHystSummerF = v;
-        eeprom_saveEnvSeasonHyst();
+    if (v < cmd->minVal || v > cmd->maxVal) {
+        publishAck(name, false, v, "range", cmd);
         return;
     }
 
-    if (topic.endsWith("/spf_buffer")) {
-        int v = val.as<int>();
-        sys.envHystSpringFallF = v;
-        eeprom_saveEnvSeasonHyst();
-        return;
-    }
+    bool changed = sysf_setI(cmd->field, v * cmd->scale);
+    applied = sysf_getI(cmd->field) / cmd->scale;
 
-    if (topic.endsWith("/winter_buffer")) {
-        int v = val.as<int>();
-        sys.envHystWinterF = v;
-        eeprom_saveEnvSeasonHyst();
-        return;
-    }
+    // Unchanged values are not rewritten (data‑flash wear)
+    if (changed && cmd->save) cmd->save(applied);
 
-    if (topic.endsWith("/extreme_buffer")) {
-        int v = val.as<int>();
-        sys.envHystExtremeF = v;
-        eeprom_saveEnvSeasonHyst();
-        return;
-    }
+    publishAck(name, true, applied, nullptr, cmd);
+}
 
-    if (topic.endsWith("/summer_setpoint")) {
-        int v = val.as<int>();
-        sys.envSetpointSummerF = v;
-        eeprom_saveEnvSeasonSetpoints();
-        return;
-    }
+/* ============================================================
+ *  CUSTOM COMMANDS
+ * ============================================================ */
 
-    if (topic.endsWith("/spf_setpoint")) {
-        int v = val.as<int>();
-        sys.envSetpointSpringFallF = v;
-        eeprom_saveEnvSeasonSetpoints();
-        return;
-    }
+static bool cmdGuardianOverride(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err) {
+    int32_t v;
+    if (!commandValue(doc["value"], v)) { err = "value"; return false; }
 
-    if (topic.endsWith("/winter_setpoint")) {
-        int v = val.as<int>();
-        sys.envSetpointWinterF = v;
-        eeprom_saveEnvSeasonSetpoints();
-        return;
-    }
+    if (v) {
+        sys.emberGuardianActive  = false;
+        sys.emberGuardianStartMs = 0;
 
-    if (topic.endsWith("/extreme_setpoint")) {
-        int v = val.as<int>();
-        sys.envSetpointExtremeF = v;
-        eeprom_saveEnvSeasonSetpoints();
-        return;
+        if (sys.burnState == BURN_EMBER_GUARD) {
+            sys.burnState       = BURN_HOLD;
+            sys.holdTimerActive = true;
+            sys.holdStartMs     = millis();
+        }
     }
+    applied = v ? 1 : 0;
+    return true;
+}
 
-    // ---------------- PROBE ROLE ASSIGNMENT ----------------
+static bool cmdFactoryReset(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err) {
+    if (!(doc["confirm"] == true)) { err = "confirm"; return false; }
 
-    if (topic.endsWith("/probe_role")) {
-        if (!doc.containsKey("role") || !doc.containsKey("phys")) return;
+    factoryResetRequested = true;     // after the ack went out
+    applied = 1;
+    return true;
+}
 
-        int role = doc["role"].as<int>();
-        int phys = doc["phys"].as<int>();
+static bool cmdProbeRole(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err) {
+    if (!doc.containsKey("role") || !doc.containsKey("phys")) { err = "value"; return false; }
 
-        if (role >= 0 && role < PROBE_ROLE_COUNT &&
-            phys >= 0 && phys < MAX_WATER_PROBES) {
+    int role = doc["role"].as<int>();
+    int phys = doc["phys"].as<int>();
 
-            sys.probeRoleMap[role] = phys;
-            eeprom_saveProbeRoles();
-        }
-        return;
+    if (role < 0 || role >= PROBE_ROLE_COUNT ||
+        phys < 0 || phys >= MAX_WATER_PROBES) {
+        err = "range";
+        return false;
     }
 
-    // ---------------- BOILER CONTROL ----------------
-
-    if (topic.endsWith("/tank_low")) {
-        int v = val.as<int>();
-        sys.tankLowSetpointF = v;
-        eeprom_saveTankLow(v);
-        return;
-    }
+    if (sysf_setI(SF_PROBE_ROLES, phys, (uint8_t)role)) eeprom_saveProbeRoles();
+    applied = phys;
+    return true;
+}
 
-    if (topic.endsWith("/tank_high")) {
-        int v = val.as<int>();
-        sys.tankHighSetpointF = v;
-        eeprom_saveTankHigh(v);
-        return;
-    }
+static bool cmdTelemetry(StaticJsonDocument<256>& doc, int32_t& applied, const char*& err) {
+    applied = 0;
+    if (!handleTelemetryTuning(doc)) { err = "range"; return false; }
+    applied = 1;
+    return true;
+}
 
-    if (topic.endsWith("/control_mode")) {
-        int mode = val.as<int>();
-        if (mode < 0) mode = 0;
-        if (mode > 1) mode = 1;
-        sys.controlMode = (RunMode)mode;
-        eeprom_saveRunMode((uint8_t)mode);
-        return;
-    }
+/* ============================================================
+ *  TELEMETRY TUNING
+ *  ------------------------------------------------------------
+ *  boiler/cmd/telemetry, one entry per message:
+ *    {"field":"exhaust","abs":2.0,"rel":0.0}
+ *    {"topic":"water","heartbeat_s":120,"min_interval_ms":2000}
+ * ============================================================ */
 
-    // ---------------- EMBER GUARDIAN OVERRIDE ----------------
+static bool handleTelemetryTuning(StaticJsonDocument<256>& doc) {
+    bool changed = false;
 
-    if (topic.endsWith("/ember_guardian_override")) {
-        bool v = val.as<bool>();
-        if (v) {
-            sys.emberGuardianActive  = false;
-            sys.emberGuardianStartMs = 0;
+    if (doc.containsKey("field")) {
+        const char* key = doc["field"];
+        for (uint8_t d = 0; key && d < DEADBAND_COUNT; d++) {
+            if (strcmp(key, deadbands[d].key) != 0) continue;
 
-            if (sys.burnState == BURN_EMBER_GUARD) {
-                sys.burnState       = BURN_HOLD;
-                sys.holdTimerActive = true;
-                sys.holdStartMs     = millis();
+            if (doc.containsKey("abs")) {
+                float v = doc["abs"].as<float>();
+                if (v >= 0.0f && v <= 1000.0f) { deadbands[d].absBand = v; changed = true; }
+            }
+            if (doc.containsKey("rel")) {
+                float v = doc["rel"].as<float>();
+                if (v >= 0.0f && v <= 1.0f) { deadbands[d].relBand = v; changed = true; }
             }
+            break;
         }
-        return;
     }
 
-    // ---------------- FACTORY RESET ----------------
+    if (doc.containsKey("topic")) {
+        const char* key = doc["topic"];
+        for (uint8_t i = 0; key && i < TT_COUNT; i++) {
+            if (strcmp(key, topics[i].key) != 0) continue;
 
-    if (topic.endsWith("/factory_reset")) {
-        if (doc.containsKey("confirm") && doc["confirm"] == true) {
-            wifi_prov_factoryReset();
+            if (doc.containsKey("heartbeat_s")) {
+                uint32_t v = doc["heartbeat_s"].as<uint32_t>();
+                if (v >= 5 && v <= 86400UL) { topics[i].heartbeatMs = v * 1000UL; changed = true; }
+            }
+            if (doc.containsKey("min_interval_ms")) {
+                uint32_t v = doc["min_interval_ms"].as<uint32_t>();
+                if (v >= 100 && v <= 600000UL) { topics[i].minIntervalMs = v; changed = true; }
+            }
+            break;
         }
-        return;
     }
+
+    if (changed) mqtt_publishTelemetryConfig();
+    return changed;
 }
@@ -16,9 +16,10 @@
  *    Responsibilities:
  *      • mqtt_init() — initialize WiFi + MQTT client
  *      • mqtt_loop() — fully non‑blocking RX/TX handler
- *      • Auto‑reconnect logic (rate‑limited, deterministic)
+ *      • Stepped reconnect with exponential backoff + jitter
  *      • Home Assistant Discovery support
- *      • Periodic telemetry publishers (state, settings, water, outdoor)
+ *      • Report‑on‑change telemetry (state, settings, water, outdoor)
+ *        with per‑field deadbands and a heartbeat, periodic perf
  *
  *    Architectural Notes:
  *      - All implementation resides in MQTTClient.cpp
@@ -34,11 +35,80 @@
 #ifndef MQTT_CLIENT_H
 #define MQTT_CLIENT_H
 
+/* ============================================================
+ *  REPORT-ON-CHANGE DEFAULTS
+ *  ------------------------------------------------------------
+ *  A telemetry topic is published when a discrete field changed,
+ *  an analog field moved past its deadband, or the heartbeat
+ *  expired — never faster than the minimum interval. All values
+ *  can be retuned at runtime on boiler/cmd/telemetry.
+ * ============================================================ */
+#define MQTT_DB_EXHAUST_F        2.0f     // ±°F
+#define MQTT_DB_FAN_PCT          2.0f     // ±%
+#define MQTT_DB_WATER_F          0.5f     // ±°F, every probe
+#define MQTT_DB_OUTDOOR_F        0.5f     // ±°F
+#define MQTT_DB_HUMIDITY_PCT     1.0f     // ±%RH
+#define MQTT_DB_PRESSURE_REL     0.0005f  // ±0.05 % (~0.5 hPa)
+
+#define MQTT_MIN_INTERVAL_MS     1000UL
+#define MQTT_HB_STATE_MS         30000UL
+#define MQTT_HB_WATER_MS         60000UL
+#define MQTT_HB_OUTDOOR_MS       300000UL
+#define MQTT_HB_SETTINGS_MS      60000UL
+
+/* ============================================================
+ *  CONNECTION
+ *  ------------------------------------------------------------
+ *  Connecting still blocks the loop; each attempt stalls it for
+ *  at most one of:
+ *
+ *    RESOLVE  hostByName() on the modem, ≤ MQTT_DNS_TIMEOUT_MS
+ *             (dotted quads skip it; names are cached and only
+ *             looked up again every MQTT_DNS_REFRESH_FAILS)
+ *    CONNECT  TCP + CONNECT + CONNACK in one call,
+ *             ≤ MQTT_TCP_TIMEOUT_MS + MQTT_CONNACK_TIMEOUT_MS
+ *
+ *  i.e. ≤ 1 s, then ≤ 2 s on a later pass. Both are scheduler
+ *  blocking sections: task_control keeps running from the timer
+ *  ISR (see Scheduler.h), so only the background tasks (UI,
+ *  keypad, storage …) see the stall. Failed attempts back off
+ *  from MQTT_BACKOFF_MIN_MS (±25 % jitter) doubling to
+ *  MQTT_BACKOFF_MAX_MS: ≤ 3 s of background stall per 22 s at
+ *  first, per ~4 min once backed off. A LAN broker answers in
+ *  well under 100 ms, so the timeouts only bite when it is down.
+ * ============================================================ */
+#define MQTT_TCP_TIMEOUT_MS      1000
+#define MQTT_CONNACK_TIMEOUT_MS  1000UL
+#define MQTT_DNS_TIMEOUT_MS      1000UL
+#define MQTT_MODEM_TIMEOUT_MS    10000UL  // WiFiS3 default, restored after DNS
+#define MQTT_BACKOFF_MIN_MS      30000UL
+#define MQTT_BACKOFF_MAX_MS      300000UL
+#define MQTT_BACKOFF_JITTER_PCT  25
+#define MQTT_DNS_REFRESH_FAILS   3        // re-resolve after this many failures
+
+/* ============================================================
+ *  OUTAGE BACKFILL (boiler/history)
+ * ============================================================ */
+#define HISTORY_DRAIN_BATCH        10      // samples per message
+#define HISTORY_DRAIN_INTERVAL_MS  500UL   // 12 h backlog ≈ 36 s
+
+/* ============================================================
+ *  HOME ASSISTANT DISCOVERY PACING
+ * ============================================================ */
+#define HA_DISCOVERY_PER_TICK    2        // config publishes per mqtt_loop()
+#define HA_DISCOVERY_COLLECT_MS  1500UL   // wait for retained configs first
+
 // Initialize WiFi + MQTT subsystem
 void mqtt_init();
 
 // Non‑blocking MQTT loop (called from main loop)
 void mqtt_loop();
 
+// True while telemetry is actually going undelivered: a session
+// dropped or a connect attempt failed (until the next session is
+// up), or the unit is serving the AP portal. A first connect that
+// is still in progress does not count. Safe before mqtt_init().
+bool mqtt_outage();
+
 #endif
 
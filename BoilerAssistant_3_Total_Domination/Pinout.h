@@ -58,6 +58,13 @@
 // Damper relay (active LOW)
 #define PIN_DAMPER         D6
 
+/* ============================================================
+ *  DIGITAL INPUTS
+ * ============================================================ */
+
+// Keypad PCF8574 INT (open‑drain, active LOW, external interrupt)
+#define PIN_KEYPAD_INT     D2
+
 /* ============================================================
  *  DS18B20 WATER TEMPERATURE SENSORS (OneWire bus)
  * ============================================================ */
@@ -77,8 +84,9 @@
 
 // Chip selects (one per thermocouple)
 #define PIN_TC1_CS         D7   // CS (Chip Select) – Exhaust probe
-#define PIN_TC2_CS         D3
-#define PIN_TC3_CS         D4
-#define PIN_TC4_CS         D5
+#define PIN_TC2_CS         D3   // Secondary flue
+#define PIN_TC3_CS         D4   // Heat exchanger
+#define PIN_TC4_CS         D5   // Firebox (shares D5 with PIN_FAN_PWM:
+                                //  disabled until rewired)
 
 #endif
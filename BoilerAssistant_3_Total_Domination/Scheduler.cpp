@@ -0,0 +1,280 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Cooperative Scheduler Module (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Scheduler.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Deadline‑ordered cooperative scheduler for the main loop.
+ *    Replaces the ad‑hoc "static unsigned long lastX" timers with
+ *    a fixed task table and measurable release timing.
+ *
+ *    Scheduling rules (one sched_run() pass):
+ *      1) Run every due CRITICAL task, earliest deadline first
+ *      2) Run at most ONE due BACKGROUND task: the earliest
+ *         deadline among those whose budget ends before the next
+ *         CRITICAL release. Due tasks that do not fit are deferred
+ *         (counted once per release); a shorter one behind them
+ *         may still run
+ *
+ *    Releases stay on a fixed phase grid (release += period), so
+ *    a late pass never drifts later cadences.
+ *
+ *  Architectural Notes:
+ *      - Deadline = release + period (implicit deadlines)
+ *      - All time comparisons are signed differences (wrap‑safe)
+ *      - No dynamic allocation, no blocking
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "Scheduler.h"
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static SchedTask tasks[SCHED_MAX_TASKS];
+static uint8_t   taskCount = 0;
+
+static volatile uint8_t blockingDepth = 0;     // > 0: loop stuck in a modem call
+static volatile bool    servicing     = false; // ISR pass in progress
+
+/* ============================================================
+ *  HELPERS
+ * ============================================================ */
+
+// Signed distance a − b in ms (wrap‑safe)
+static long msDiff(unsigned long a, unsigned long b) {
+    return (long)(a - b);
+}
+
+static bool isDue(const SchedTask& t, unsigned long now) {
+    return msDiff(now, t.nextReleaseMs) >= 0;
+}
+
+static unsigned long deadlineOf(const SchedTask& t) {
+    return t.nextReleaseMs + t.periodMs;
+}
+
+// Earliest‑deadline due task of the given class that fits in
+// maxBudgetMs, or -1. A due task that does not fit counts one
+// deferral per release, however many passes it then waits.
+static int8_t pickDue(SchedClass cls, unsigned long now,
+                      unsigned long maxBudgetMs = 0xFFFFFFFFUL) {
+    int8_t best = -1;
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        SchedTask& t = tasks[i];
+        if (t.cls != cls || !isDue(t, now)) continue;
+
+        if ((t.budgetUs + 999UL) / 1000UL > maxBudgetMs) {
+            if (!t.deferred) {
+                t.deferrals++;
+                t.deferred = true;
+            }
+            continue;
+        }
+
+        if (best < 0 ||
+            msDiff(deadlineOf(t), deadlineOf(tasks[best])) < 0) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Earliest upcoming CRITICAL release (far future if none registered)
+static unsigned long nextCriticalRelease(unsigned long now) {
+    bool          found = false;
+    unsigned long next  = now;
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const SchedTask& t = tasks[i];
+        if (t.cls != SCHED_CRITICAL) continue;
+
+        if (!found || msDiff(t.nextReleaseMs, next) < 0) {
+            next  = t.nextReleaseMs;
+            found = true;
+        }
+    }
+    return found ? next : now + 0x7FFFFFFFUL;
+}
+
+static void runTask(SchedTask& t, unsigned long now) {
+    unsigned long lateness = (unsigned long)msDiff(now, t.nextReleaseMs);
+    if (lateness > SCHED_LATE_TOLERANCE_MS) t.lateStarts++;
+    if (lateness > t.maxLatenessMs)         t.maxLatenessMs = lateness;
+
+    unsigned long startUs = micros();
+    t.fn(now);
+    unsigned long runUs = micros() - startUs;
+
+    t.runs++;
+    t.deferred  = false;
+    t.lastRunUs = runUs;
+    if (runUs > t.maxRunUs)   t.maxRunUs = runUs;
+    if (runUs > t.budgetUs)   t.overruns++;
+
+    // Advance on the phase grid; skip releases that were missed entirely.
+    // A triggered run returns to the grid release it was pulled from.
+    if (t.triggered) {
+        t.triggered     = false;
+        t.nextReleaseMs = t.gridReleaseMs;
+    } else {
+        t.nextReleaseMs += t.periodMs;
+    }
+    if (msDiff(t.nextReleaseMs, now) <= 0) {
+        unsigned long missed = (unsigned long)msDiff(now, t.nextReleaseMs) / t.periodMs + 1;
+        t.nextReleaseMs += missed * t.periodMs;
+    }
+}
+
+/* ============================================================
+ *  REGISTRATION
+ * ============================================================ */
+int8_t sched_addTask(const char* name,
+                     SchedTaskFn fn,
+                     unsigned long periodMs,
+                     unsigned long phaseMs,
+                     unsigned long budgetUs,
+                     SchedClass cls)
+{
+    if (taskCount >= SCHED_MAX_TASKS || !fn || periodMs == 0) return -1;
+
+    SchedTask& t = tasks[taskCount];
+    memset(&t, 0, sizeof(t));
+
+    t.name          = name;
+    t.fn            = fn;
+    t.periodMs      = periodMs;
+    t.phaseMs       = phaseMs;
+    t.budgetUs      = budgetUs;
+    t.cls           = cls;
+    t.nextReleaseMs = millis() + phaseMs;
+
+    return (int8_t)taskCount++;
+}
+
+void sched_start(unsigned long nowMs) {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        tasks[i].nextReleaseMs = nowMs + tasks[i].phaseMs;
+        tasks[i].triggered     = false;
+        tasks[i].deferred      = false;
+    }
+}
+
+void sched_trigger(int8_t id) {
+    if (id < 0 || id >= taskCount) return;
+
+    SchedTask& t = tasks[id];
+
+    unsigned long now = millis();
+    if (!isDue(t, now)) {
+        // Pull the release forward; runTask() restores the grid release
+        t.gridReleaseMs = t.nextReleaseMs;
+        t.triggered     = true;
+        t.nextReleaseMs = now;
+    }
+}
+
+/* ============================================================
+ *  ONE SCHEDULER PASS
+ * ============================================================ */
+void sched_run() {
+    unsigned long now = millis();
+
+    /* 1) CRITICAL — everything that is due, deadline order */
+    int8_t id;
+    while ((id = pickDue(SCHED_CRITICAL, now)) >= 0) {
+        runTask(tasks[id], now);
+        now = millis();
+    }
+
+    /* 2) BACKGROUND — one task, the earliest that fits before the tick */
+    long slackMs = msDiff(nextCriticalRelease(now), now);
+    if (slackMs < 0) slackMs = 0;
+
+    id = pickDue(SCHED_BACKGROUND, now, (unsigned long)slackMs);
+    if (id < 0) return;
+
+    runTask(tasks[id], now);
+}
+
+/* ============================================================
+ *  BLOCKING SECTIONS
+ *  ------------------------------------------------------------
+ *  The loop is parked inside one known call, so the only state
+ *  shared with an ISR‑run CRITICAL task is what that call uses
+ *  (the modem UART). Nothing here disables interrupts.
+ * ============================================================ */
+void sched_blockingBegin() {
+    blockingDepth++;
+}
+
+void sched_blockingEnd() {
+    if (blockingDepth) blockingDepth--;
+}
+
+void sched_serviceCritical() {
+    if (blockingDepth == 0 || servicing) return;
+    servicing = true;
+
+    unsigned long now = millis();
+    int8_t id;
+    while ((id = pickDue(SCHED_CRITICAL, now)) >= 0) {
+        runTask(tasks[id], now);
+        now = millis();
+    }
+
+    servicing = false;
+}
+
+/* ============================================================
+ *  STATISTICS
+ * ============================================================ */
+uint8_t sched_taskCount() {
+    return taskCount;
+}
+
+const SchedTask* sched_getTask(uint8_t id) {
+    if (id >= taskCount) return nullptr;
+    return &tasks[id];
+}
+
+void sched_resetStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        SchedTask& t = tasks[i];
+        t.runs          = 0;
+        t.lateStarts    = 0;
+        t.overruns      = 0;
+        t.deferrals     = 0;
+        t.maxLatenessMs = 0;
+        t.lastRunUs     = 0;
+        t.maxRunUs      = 0;
+    }
+}
+
+void sched_printReport(Print& out) {
+    char line[96];
+
+    out.println("SCHED: task       runs    late  over  defer  maxLateMs  maxRunUs");
+
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const SchedTask& t = tasks[i];
+        snprintf(line, sizeof(line),
+                 "SCHED: %-10s %7lu %5lu %5lu %6lu %10lu %9lu",
+                 t.name,
+                 (unsigned long)t.runs,
+                 (unsigned long)t.lateStarts,
+                 (unsigned long)t.overruns,
+                 (unsigned long)t.deferrals,
+                 t.maxLatenessMs,
+                 t.maxRunUs);
+        out.println(line);
+    }
+}
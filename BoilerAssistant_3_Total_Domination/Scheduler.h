@@ -0,0 +1,149 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Cooperative Scheduler API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Scheduler.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Public interface for the deadline‑ordered cooperative task
+ *    scheduler that drives the main loop. Every periodic subsystem
+ *    registers once at boot with:
+ *
+ *      • period   — release interval in ms
+ *      • phase    — offset of the first release in ms
+ *      • budget   — expected worst‑case run time in µs
+ *      • class    — CRITICAL (control path) or BACKGROUND
+ *
+ *    Each sched_run() pass executes every due CRITICAL task in
+ *    deadline order, then at most ONE due BACKGROUND task: the
+ *    earliest‑deadline one whose budget fits before the next
+ *    CRITICAL release. A background task may follow the control
+ *    tick in the same pass, but it only starts when its budget
+ *    fits before the next CRITICAL release, so the tick is on time
+ *    as long as the task stays within that budget. A short task
+ *    (keypad) can still run in the gap a long one (network) does
+ *    not fit.
+ *
+ *    Per‑task statistics:
+ *      • runs, late starts, budget overruns, deferrals (releases
+ *        that waited at least once for a slot their budget fits)
+ *      • worst lateness (ms) and last / worst run time (µs)
+ *
+ *    Blocking sections: a few modem calls cannot be split (MQTT
+ *    connect, DNS). They are bracketed with sched_blockingBegin()/
+ *    sched_blockingEnd(), and a periodic timer ISR calls
+ *    sched_serviceCritical(), which runs due CRITICAL tasks only
+ *    while the loop is stuck inside such a section. The control
+ *    tick then starts at most 1000/SCHED_SERVICE_HZ ms late.
+ *
+ *  Architectural Notes:
+ *      - Fixed task table, no dynamic allocation
+ *      - All timing uses millis()/micros() and is wrap‑safe
+ *      - Tasks must be non‑blocking; the scheduler only preempts
+ *        inside a blocking section, and only with CRITICAL tasks
+ *      - All implementation resides in Scheduler.cpp
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+/* ============================================================
+ *  CONFIGURATION
+ * ============================================================ */
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 12
+#endif
+
+// A release started more than this many ms late counts as a late start
+#ifndef SCHED_LATE_TOLERANCE_MS
+#define SCHED_LATE_TOLERANCE_MS 10
+#endif
+
+// Rate of the timer ISR that calls sched_serviceCritical()
+#ifndef SCHED_SERVICE_HZ
+#define SCHED_SERVICE_HZ 100
+#endif
+
+/* ============================================================
+ *  TYPES
+ * ============================================================ */
+typedef void (*SchedTaskFn)(unsigned long nowMs);
+
+typedef enum {
+    SCHED_CRITICAL   = 0,   // control path, always runs when due
+    SCHED_BACKGROUND = 1    // one per pass, only if budget fits
+} SchedClass;
+
+struct SchedTask {
+    const char*   name;
+    SchedTaskFn   fn;
+    unsigned long periodMs;
+    unsigned long phaseMs;
+    unsigned long budgetUs;
+    SchedClass    cls;
+
+    unsigned long nextReleaseMs;
+    unsigned long gridReleaseMs;    // grid release saved by sched_trigger()
+    bool          triggered;
+    bool          deferred;         // this release already counted a deferral
+
+    // Statistics
+    uint32_t      runs;
+    uint32_t      lateStarts;
+    uint32_t      overruns;
+    uint32_t      deferrals;
+    unsigned long maxLatenessMs;
+    unsigned long lastRunUs;
+    unsigned long maxRunUs;
+};
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Register a task. Returns its id, or -1 if the table is full
+// or periodMs is 0.
+int8_t sched_addTask(const char* name,
+                     SchedTaskFn fn,
+                     unsigned long periodMs,
+                     unsigned long phaseMs,
+                     unsigned long budgetUs,
+                     SchedClass cls);
+
+// Anchor all releases to nowMs (call once after registration)
+void sched_start(unsigned long nowMs);
+
+// Execute one scheduler pass (called from loop())
+void sched_run();
+
+// Release a task immediately on the next pass (e.g. UI after a key);
+// its next release returns to the original phase grid
+void sched_trigger(int8_t id);
+
+// Bracket a call that blocks the loop (may nest). CRITICAL tasks
+// it touches no state of may then run from sched_serviceCritical().
+void sched_blockingBegin();
+void sched_blockingEnd();
+
+// Timer ISR hook: run due CRITICAL tasks, but only while the loop
+// is inside a blocking section; a no‑op otherwise
+void sched_serviceCritical();
+
+// Statistics access
+uint8_t          sched_taskCount();
+const SchedTask* sched_getTask(uint8_t id);
+void             sched_resetStats();
+
+// Print a one‑line‑per‑task report
+void sched_printReport(Print& out);
+
+#endif
@@ -11,7 +11,7 @@
  *    Unified sensor subsystem for the Boiler Assistant controller.
  *    Implements deterministic acquisition of:
  *
- *      • MAX31855 exhaust thermocouple
+ *      • MAX31855 exhaust thermocouple (via Thermocouples.h)
  *      • DS18B20 water probes (up to MAX_WATER_PROBES)
  *      • BME280 outdoor environmental sensor
  *
@@ -24,8 +24,13 @@
  *
  *  Architectural Notes:
  *      - Exhaust readings use a 250 ms cache to avoid MAX31855 spam
+ *      - The exhaust filter (ExhaustFilter.h) runs once per fresh sample
  *      - Water probes use 20% smoothing for stable tank readings
+ *      - DS18B20 conversions are awaited without blocking; one
+ *        probe scratchpad (CRC checked) is read per poll
  *      - BME280 values are read only when envSensorOK is true
+ *      - BME280 runs in forced mode: one burst read per update
+ *      - Published values go through the SystemFields setters
  *      - This module contains no UI, MQTT, or EEPROM logic
  *
  *  Version:
@@ -38,12 +43,14 @@
 #include "SystemState.h"
 #include "EEPROMStorage.h"
 #include "Pinout.h"
+#include "ExhaustFilter.h"
+#include "Thermocouples.h"
+#include "EnvSensor.h"
+#include "SystemFields.h"
 
 #include <Arduino.h>
 #include <OneWire.h>
 #include <DallasTemperature.h>
-#include <Adafruit_BME280.h>
-#include <Adafruit_MAX31855.h>
 
 /* ============================================================
  *  GLOBALS
@@ -56,40 +63,44 @@ static OneWire oneWire(PIN_DS18B20_DATA);
 static DallasTemperature waterSensors(&oneWire);
 static DeviceAddress probeAddr[MAX_WATER_PROBES];
 
-// BME280
-static Adafruit_BME280 bme;
-
-static Adafruit_MAX31855 max31855(
-    PIN_MAX31855_SCK,
-    PIN_TC1_CS,
-    PIN_MAX31855_MISO
-);
-
 static unsigned long lastExhaustReadMs = 0;
-static double lastExhaustF = NAN;
+static float lastExhaustF = NAN;
 
 /* ============================================================
- *  EXHAUST SENSOR (MAX31855)
+ *  EXHAUST SENSOR (MAX31855 TC1)
+ *  ------------------------------------------------------------
+ *  Each 250 ms poll reads TC1 plus one secondary channel, so
+ *  TC2..TC4 refresh every 750 ms at one SPI frame apiece.
  * ============================================================ */
 
-double exhaust_readF_cached() {
+bool exhaust_poll() {
     unsigned long now = millis();
-    if (now - lastExhaustReadMs < 250) {
-        return lastExhaustF;
+    if (now - lastExhaustReadMs < EXHAUST_MIN_INTERVAL_MS) {
+        return false;
     }
 
     lastExhaustReadMs = now;
 
-    double c = max31855.readCelsius();
+    bool ok = tc_sample(TC_EXHAUST);
+    tc_pollSecondary();
 
-    if (isnan(c)) {
-        sys.exhaustSensorOK = false;
-        return lastExhaustF;
+    if (!ok) {
+        sysf_setI(SF_EXHAUST_OK, false);
+        return false;
     }
 
-    sys.exhaustSensorOK = true;
+    sysf_setI(SF_EXHAUST_OK, true);
+
+    lastExhaustF = sys.tcTempF[TC_EXHAUST];
 
-    lastExhaustF = c * 9.0 / 5.0 + 32.0;
+    // Single filter stage — exactly once per fresh sample
+    sysf_setF(SF_EXHAUST_RAW,    lastExhaustF);   // raw flue temp for Guardian
+    sysf_setF(SF_EXHAUST_SMOOTH, exhfilter_push(lastExhaustF, now));
+    return true;
+}
+
+float exhaust_readF_cached() {
+    exhaust_poll();
     return lastExhaustF;
 }
 
@@ -112,27 +123,99 @@ void scanWaterProbes() {
 }
 
 /* ============================================================
- *  WATER PROBE READ
+ *  WATER PROBE READ (non‑blocking state machine)
+ *  ------------------------------------------------------------
+ *  IDLE        → start a bus‑wide conversion (Skip ROM + 0x44)
+ *  CONVERTING  → wait out t_conv for the configured resolution
+ *  READING     → one probe scratchpad per call, CRC checked
+ *
+ *  A new cycle starts WATER_PROBE_CYCLE_MS after the previous one.
  * ============================================================ */
 
-void sensors_readWaterProbes() {
-    if (sys.waterProbeCount == 0) return;
+enum WaterProbeState : uint8_t {
+    WP_IDLE,
+    WP_CONVERTING,
+    WP_READING
+};
+
+static WaterProbeState wpState      = WP_IDLE;
+static unsigned long   wpCycleStart = 0;
+static unsigned long   wpConvStart  = 0;
+static uint8_t         wpNext       = 0;
+static bool            wpStarted    = false;
+
+// DS18B20 t_conv: 750 ms at 12 bit, halved per bit below (+1 ms margin)
+static unsigned long waterProbeConvMs() {
+    return (750UL >> (12 - WATER_PROBE_RESOLUTION)) + 1;
+}
 
-    waterSensors.requestTemperatures();
+// Read one probe's scratchpad. Returns false on bus or CRC error.
+static bool readProbe(uint8_t i, float* tempC) {
+    uint8_t sp[9];
 
-    for (uint8_t i = 0; i < sys.waterProbeCount; i++) {
-        float c = waterSensors.getTempC(probeAddr[i]);
+    if (!oneWire.reset()) return false;
+    oneWire.select(probeAddr[i]);
+    oneWire.write(0xBE);                    // READ SCRATCHPAD
+    oneWire.read_bytes(sp, sizeof(sp));
+
+    if (OneWire::crc8(sp, 8) != sp[8]) return false;
+
+    // Undefined low bits at reduced resolution
+    int16_t raw = (int16_t)((sp[1] << 8) | sp[0]);
+    raw &= (int16_t)(0xFFFF << (12 - WATER_PROBE_RESOLUTION));
+
+    *tempC = (float)raw / 16.0f;
+    return true;
+}
+
+bool sensors_pollWaterProbes() {
+    if (sys.waterProbeCount == 0) return false;
+
+    unsigned long now = millis();
+
+    switch (wpState) {
+
+        case WP_IDLE:
+            if (wpStarted && now - wpCycleStart < WATER_PROBE_CYCLE_MS) {
+                return false;
+            }
+            wpStarted    = true;
+            wpCycleStart = now;
+
+            waterSensors.requestTemperatures();   // returns at once
+            wpConvStart = now;
+            wpState     = WP_CONVERTING;
+            return false;
+
+        case WP_CONVERTING:
+            if (now - wpConvStart < waterProbeConvMs()) {
+                return false;
+            }
+            wpNext  = 0;
+            wpState = WP_READING;
+            // fall through: read the first probe on this call
+
+        case WP_READING: {
+            uint8_t i = wpNext++;
+            if (wpNext >= sys.waterProbeCount) {
+                wpState = WP_IDLE;
+            }
+
+            float c;
+            if (!readProbe(i, &c)) return false;   // keep last value
+            if (c <= -55 || c >= 125) return false;
 
-        if (c > -55 && c < 125) {
             float newF = c * 9.0f / 5.0f + 32.0f;
 
-            if (isnan(sys.waterTempF[i])) {
-                sys.waterTempF[i] = newF;
-            } else {
-                sys.waterTempF[i] = sys.waterTempF[i] * 0.8f + newF * 0.2f;
+            if (!isnan(sys.waterTempF[i])) {
+                newF = sys.waterTempF[i] * 0.8f + newF * 0.2f;
             }
+            sysf_setF(SF_WATER_TEMP, newF, i);
+            return true;
         }
     }
+
+    return false;
 }
 
 /* ============================================================
@@ -142,13 +225,12 @@ void sensors_readWaterProbes() {
 void sensors_readBME280() {
     if (!sys.envSensorOK) return;
 
-    float t = bme.readTemperature();
-    float h = bme.readHumidity();
-    float p = bme.readPressure();
+    float t, h, p;
+    if (!envsensor_read(&t, &h, &p)) return;
 
-    if (!isnan(t)) sys.envTempF    = t * 9.0f / 5.0f + 32.0f;
-    if (!isnan(h)) sys.envHumidity = h;
-    if (!isnan(p)) sys.envPressure = p / 100.0f;
+    if (!isnan(t)) sysf_setF(SF_ENV_TEMP,     t * 9.0f / 5.0f + 32.0f);
+    if (!isnan(h)) sysf_setF(SF_ENV_HUMIDITY, h);
+    if (!isnan(p)) sysf_setF(SF_ENV_PRESSURE, p / 100.0f);
 }
 
 /* ============================================================
@@ -156,8 +238,11 @@ void sensors_readBME280() {
  * ============================================================ */
 
 bool sensors_init() {
+    exhfilter_init();
+    tc_init();
+
     // BME280
-    bool ok = bme.begin(0x76);
+    bool ok = envsensor_begin(0x76);
     sys.envSensorOK = ok;
 
     // DS18B20
@@ -167,7 +252,7 @@ bool sensors_init() {
     scanWaterProbes();
 
     for (uint8_t i = 0; i < sys.waterProbeCount; i++) {
-        waterSensors.setResolution(probeAddr[i], 9);
+        waterSensors.setResolution(probeAddr[i], WATER_PROBE_RESOLUTION);
     }
 
     return ok;
@@ -178,17 +263,8 @@ bool sensors_init() {
  * ============================================================ */
 
 void sensors_readAll() {
-    double rawF = exhaust_readF_cached();
-
-    // v3.x exhaust smoothing
-    sys.exhaustRawF = rawF;
-
-    static double last = NAN;
-    if (isnan(last)) last = rawF;
-    last = (last * 0.90) + (rawF * 0.10);
-
-    sys.exhaustSmoothF = last;
+    exhaust_poll();
 
-    sensors_readWaterProbes();
+    sensors_pollWaterProbes();
     sensors_readBME280();
 }
@@ -11,8 +11,8 @@
  *    Public interface for the unified sensor subsystem. Provides
  *    deterministic access to:
  *
- *      • MAX31855 exhaust thermocouple (cached reads)
- *      • DS18B20 water probes (scan + read)
+ *      • MAX31855 exhaust thermocouple (cached reads + filter stage)
+ *      • DS18B20 water probes (scan + async conversion / read)
  *      • BME280 outdoor environmental sensor
  *
  *    Architectural Notes:
@@ -36,16 +36,41 @@
 // Initialize BME280, DS18B20, MAX31855
 bool sensors_init();
 
-// Read MAX31855 (cached)
-double exhaust_readF_cached();
+// Poll MAX31855 TC1 and one secondary channel. On a
+// fresh exhaust sample, runs the exhaust filter once and updates
+// sys.exhaustRawF / sys.exhaustSmoothF.
+// Returns true only when a fresh sample was taken.
+bool exhaust_poll();
+
+// Read MAX31855 (cached raw °F)
+float exhaust_readF_cached();
 
 // Scan DS18B20 probes and populate sys.waterProbeCount
 void scanWaterProbes();
 
-// Read DS18B20 water probes into sys.waterTempF[]
-void sensors_readWaterProbes();
+// DS18B20 resolution (9–12 bit) and conversion cycle period
+#ifndef WATER_PROBE_RESOLUTION
+#define WATER_PROBE_RESOLUTION 9
+#endif
+
+#ifndef WATER_PROBE_CYCLE_MS
+#define WATER_PROBE_CYCLE_MS 500
+#endif
+
+// Minimum spacing between exhaust samples. Kept well under the 250 ms
+// control period so scheduler jitter never makes a pass skip its read;
+// it only stops back-to-back calls from re-sampling the MAX31855.
+#ifndef EXHAUST_MIN_INTERVAL_MS
+#define EXHAUST_MIN_INTERVAL_MS 200
+#endif
+
+// Advance the DS18B20 state machine by one step (never blocks on
+// conversion). Call often; each call reads at most one probe into
+// sys.waterTempF[]. Returns true when a probe value was updated.
+bool sensors_pollWaterProbes();
 
 // Read BME280 into sys.envTempF / sys.envHumidity / sys.envPressure
+// (one forced‑mode burst read, see EnvSensor.h)
 void sensors_readBME280();
 
 // Read all sensors (exhaust + water + BME)
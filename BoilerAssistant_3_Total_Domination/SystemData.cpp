@@ -120,6 +120,13 @@ void systemdata_init()
     sys.exhaustRawF     = NAN;
     sys.exhaustSetpoint = 450;
 
+    /* THERMOCOUPLES */
+    for (uint8_t i = 0; i < TC_CHANNELS; i++) {
+        sys.tcTempF[i]         = NAN;
+        sys.tcColdJunctionF[i] = NAN;
+        sys.tcFault[i]         = 0;
+    }
+
     /* FAN CONTROL */
     sys.clampMinPercent = 10;
     sys.clampMaxPercent = 60;
@@ -57,6 +57,13 @@ struct SystemData
     float exhaustRawF;        // raw flue temp for Guardian
     int   exhaustSetpoint;
 
+    /* ------------------------------
+     *  THERMOCOUPLES (TcChannel index)
+     * ------------------------------ */
+    float   tcTempF[TC_CHANNELS];          // NaN = fault / disabled
+    float   tcColdJunctionF[TC_CHANNELS];
+    uint8_t tcFault[TC_CHANNELS];          // TC_FAULT_* bits
+
     /* ------------------------------
      *  FAN CONTROL
      * ------------------------------ */
@@ -0,0 +1,211 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – SystemData Field Registry (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: SystemFields.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Generated field table, typed setters and per‑consumer dirty
+ *    masks for SystemFields.h.
+ *
+ *  Architectural Notes:
+ *      - The shadow is a full SystemData copy; only registered
+ *        fields are ever compared or copied
+ *      - Runs in the cooperative scheduler only (no ISR access)
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "SystemFields.h"
+
+#include <stddef.h>
+
+extern SystemData sys;
+
+/* ============================================================
+ *  FIELD TABLE
+ * ============================================================ */
+#define SYSF_ELEM_SIZE(member, count) (uint8_t)(sizeof(((SystemData*)0)->member) / (count))
+
+static const SysFieldInfo fieldTable[SF_COUNT] = {
+#define SYSF_ROW(id, member, count, type, key, unit, lo, hi, res) \
+    { key, unit, (uint16_t)offsetof(SystemData, member), SFT_##type, count, \
+      SYSF_ELEM_SIZE(member, count), (float)(lo), (float)(hi), (float)(res) },
+    SYSF_FIELDS(SYSF_ROW)
+#undef SYSF_ROW
+};
+
+static_assert(SF_COUNT <= 64, "SysFieldMask holds at most 64 fields");
+
+// Storage checks: element count and size must match the declared type
+#define SYSF_SIZE_BOOL sizeof(bool)
+#define SYSF_SIZE_U8   sizeof(uint8_t)
+#define SYSF_SIZE_I16  sizeof(int16_t)
+#define SYSF_SIZE_I32  sizeof(int32_t)
+#define SYSF_SIZE_U32  sizeof(uint32_t)
+#define SYSF_SIZE_F32  sizeof(float)
+#define SYSF_SIZE_ENUM sizeof(((SystemData*)0)->burnState)
+
+#define SYSF_CHECK(id, member, count, type, key, unit, lo, hi, res) \
+    static_assert(sizeof(((SystemData*)0)->member) == (count) * SYSF_SIZE_##type, \
+                  "SYSF_FIELDS: " #member " does not match its declared type");
+SYSF_FIELDS(SYSF_CHECK)
+#undef SYSF_CHECK
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static SystemData   shadow;
+static SysFieldMask dirty[SYSF_CONSUMER_COUNT];
+
+static uint8_t* elemPtr(SystemData& d, const SysFieldInfo& fi, uint8_t idx) {
+    return (uint8_t*)&d + fi.offset + (size_t)idx * fi.size;
+}
+
+/* ============================================================
+ *  RAW ACCESS
+ * ============================================================ */
+static int32_t readInt(const uint8_t* p, const SysFieldInfo& fi) {
+    switch (fi.type) {
+        case SFT_BOOL: return *(const bool*)p ? 1 : 0;
+        case SFT_U8:   return *p;
+        case SFT_I16:  return *(const int16_t*)p;
+        case SFT_I32:  return *(const int32_t*)p;
+        case SFT_U32:  return (int32_t)*(const uint32_t*)p;
+        case SFT_F32:  return (int32_t)lroundf(*(const float*)p);
+        case SFT_ENUM:
+            if (fi.size == 1) return *(const int8_t*)p;
+            if (fi.size == 2) return *(const int16_t*)p;
+            return *(const int32_t*)p;
+    }
+    return 0;
+}
+
+static void writeInt(uint8_t* p, const SysFieldInfo& fi, int32_t v) {
+    switch (fi.type) {
+        case SFT_BOOL: *(bool*)p     = (v != 0);    break;
+        case SFT_U8:   *p            = (uint8_t)v;  break;
+        case SFT_I16:  *(int16_t*)p  = (int16_t)v;  break;
+        case SFT_I32:  *(int32_t*)p  = v;           break;
+        case SFT_U32:  *(uint32_t*)p = (uint32_t)v; break;
+        case SFT_F32:  *(float*)p    = (float)v;    break;
+        case SFT_ENUM:
+            if (fi.size == 1)      *(int8_t*)p  = (int8_t)v;
+            else if (fi.size == 2) *(int16_t*)p = (int16_t)v;
+            else                   *(int32_t*)p = v;
+            break;
+    }
+}
+
+/* ============================================================
+ *  CHANGE DETECTION
+ * ============================================================ */
+static bool differs(const uint8_t* a, const uint8_t* b, const SysFieldInfo& fi) {
+    if (fi.type != SFT_F32) return memcmp(a, b, fi.size) != 0;
+
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+
+    if (isnan(x) || isnan(y)) return isnan(x) != isnan(y);
+    if (fi.res > 0) return lroundf(x / fi.res) != lroundf(y / fi.res);
+    return x != y;
+}
+
+static void mark(SysField f) {
+    SysFieldMask bit = (SysFieldMask)1 << f;
+    for (uint8_t c = 0; c < SYSF_CONSUMER_COUNT; c++) dirty[c] |= bit;
+}
+
+// Compare one element with the shadow; on change copy it and mark
+static bool syncElement(SysField f, uint8_t idx) {
+    const SysFieldInfo& fi = fieldTable[f];
+    uint8_t* cur = elemPtr(sys, fi, idx);
+    uint8_t* old = elemPtr(shadow, fi, idx);
+
+    if (!differs(cur, old, fi)) return false;
+
+    memcpy(old, cur, fi.size);
+    mark(f);
+    return true;
+}
+
+/* ============================================================
+ *  PUBLIC API
+ * ============================================================ */
+void sysf_init() {
+    memcpy(&shadow, &sys, sizeof(SystemData));
+    for (uint8_t c = 0; c < SYSF_CONSUMER_COUNT; c++) dirty[c] = SF_ALL;
+}
+
+const SysFieldInfo* sysf_info(SysField f) {
+    return (f < SF_COUNT) ? &fieldTable[f] : nullptr;
+}
+
+bool sysf_setF(SysField f, float v, uint8_t idx) {
+    if (f >= SF_COUNT) return false;
+    const SysFieldInfo& fi = fieldTable[f];
+    if (idx >= fi.count) return false;
+
+    if (!isnan(v)) {
+        if (v < fi.minVal) v = fi.minVal;
+        if (v > fi.maxVal) v = fi.maxVal;
+    }
+
+    uint8_t* p = elemPtr(sys, fi, idx);
+    if (fi.type == SFT_F32) *(float*)p = v;
+    else if (!isnan(v))     writeInt(p, fi, (int32_t)lroundf(v));
+
+    return syncElement(f, idx);
+}
+
+bool sysf_setI(SysField f, int32_t v, uint8_t idx) {
+    if (f >= SF_COUNT) return false;
+    const SysFieldInfo& fi = fieldTable[f];
+    if (idx >= fi.count) return false;
+
+    if (v < (int32_t)fi.minVal) v = (int32_t)fi.minVal;
+    if (v > (int32_t)fi.maxVal) v = (int32_t)fi.maxVal;
+
+    writeInt(elemPtr(sys, fi, idx), fi, v);
+    return syncElement(f, idx);
+}
+
+float sysf_getF(SysField f, uint8_t idx) {
+    if (f >= SF_COUNT || idx >= fieldTable[f].count) return NAN;
+    const SysFieldInfo& fi = fieldTable[f];
+    const uint8_t* p = elemPtr(sys, fi, idx);
+    return (fi.type == SFT_F32) ? *(const float*)p : (float)readInt(p, fi);
+}
+
+int32_t sysf_getI(SysField f, uint8_t idx) {
+    if (f >= SF_COUNT || idx >= fieldTable[f].count) return 0;
+    const SysFieldInfo& fi = fieldTable[f];
+    return readInt(elemPtr(sys, fi, idx), fi);
+}
+
+void sysf_touch(SysField f) {
+    if (f < SF_COUNT) mark(f);
+}
+
+void sysf_sync() {
+    for (uint8_t f = 0; f < SF_COUNT; f++) {
+        for (uint8_t i = 0; i < fieldTable[f].count; i++) {
+            syncElement((SysField)f, i);
+        }
+    }
+}
+
+SysFieldMask sysf_take(SysConsumer c) {
+    if (c >= SYSF_CONSUMER_COUNT) return 0;
+
+    sysf_sync();
+
+    SysFieldMask m = dirty[c];
+    dirty[c] = 0;
+    return m;
+}
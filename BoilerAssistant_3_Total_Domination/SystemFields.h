@@ -0,0 +1,194 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – SystemData Field Registry (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: SystemFields.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    One table describing every SystemData field that leaves the
+ *    controller (LCD, MQTT, HTTP, LoRa): ID, storage type, element
+ *    count, wire key, unit, valid range and change resolution.
+ *
+ *    Each field has a dirty bit. Every consumer owns its own copy
+ *    of the dirty mask and takes (reads + clears) it when it is
+ *    ready to send, so MQTT publishing never hides a change from
+ *    the UI and vice versa.
+ *
+ *    Change detection:
+ *      - sysf_setF() / sysf_setI() write, clamp to range and mark
+ *        the field if it changed
+ *      - sysf_sync() catches direct sys.* writes (burn engine,
+ *        UI edit pointers, EEPROM load) by comparing against a
+ *        shadow of the last value seen; sysf_take() runs it first
+ *      - Floats only count as changed when they move across a
+ *        multiple of the field resolution (display precision)
+ *
+ *  Architectural Notes:
+ *      - SYSF_FIELDS is the single list; enum, table and size
+ *        checks are generated from it
+ *      - At most 64 fields (SysFieldMask is uint64_t)
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef SYSTEM_FIELDS_H
+#define SYSTEM_FIELDS_H
+
+#include <Arduino.h>
+#include "SystemState.h"
+#include "SystemData.h"
+
+/* ============================================================
+ *  FIELD LIST
+ *  ------------------------------------------------------------
+ *  X(ID, member, count, type, key, unit, min, max, res)
+ *    type: BOOL U8 I16 I32 U32 F32 ENUM
+ *    res:  float change resolution (0 for integer types)
+ * ============================================================ */
+#define SYSF_FIELDS(X) \
+    /* Live process values */ \
+    X(EXHAUST_SMOOTH,   exhaustSmoothF,        1,                F32,  "exhaust",          "F",    -460, 3300, 1.0f) \
+    X(EXHAUST_RAW,      exhaustRawF,           1,                F32,  "exhaust_raw",      "F",    -460, 3300, 1.0f) \
+    X(EXHAUST_OK,       exhaustSensorOK,       1,                BOOL, "exhaust_ok",       "",        0,    1, 0) \
+    X(WATER_COUNT,      waterProbeCount,       1,                U8,   "water_count",      "",        0, MAX_WATER_PROBES, 0) \
+    X(WATER_TEMP,       waterTempF,            MAX_WATER_PROBES, F32,  "water",            "F",     -70,  260, 0.1f) \
+    X(PROBE_ROLES,      probeRoleMap,          PROBE_ROLE_COUNT, U8,   "probe_roles",      "",        0, MAX_WATER_PROBES - 1, 0) \
+    X(TC_TEMP,          tcTempF,               TC_CHANNELS,      F32,  "tc",               "F",    -460, 3300, 1.0f) \
+    X(TC_FAULT,         tcFault,               TC_CHANNELS,      U8,   "tc_fault",         "",        0,  255, 0) \
+    X(FAN_FINAL,        fanFinal,              1,                I32,  "fan",              "%",       0,  100, 0) \
+    X(BURN_STATE,       burnState,             1,                ENUM, "state",            "",        0,    4, 0) \
+    X(SAFETY_STATE,     safetyState,           1,                ENUM, "safety_state",     "",        0,    1, 0) \
+    X(ENV_OK,           envSensorOK,           1,                BOOL, "outdoor_ok",       "",        0,    1, 0) \
+    X(ENV_TEMP,         envTempF,              1,                F32,  "outdoor_temp",     "F",     -60,  190, 0.1f) \
+    X(ENV_HUMIDITY,     envHumidity,           1,                F32,  "outdoor_hum",      "%",       0,  100, 0.1f) \
+    X(ENV_PRESSURE,     envPressure,           1,                F32,  "outdoor_pres",     "hPa",   300, 1100, 0.1f) \
+    X(GUARDIAN_ACTIVE,  emberGuardianActive,   1,                BOOL, "ember_guardian_active",  "", 0,  1, 0) \
+    X(GUARDIAN_LATCHED, emberGuardianLatched,  1,                BOOL, "ember_guardian_latched", "", 0,  1, 0) \
+    X(GUARDIAN_TIMER,   emberGuardianTimerActive, 1,             BOOL, "ember_guardian_timer",   "", 0,  1, 0) \
+    X(ACTIVE_SEASON,    envActiveSeason,       1,                ENUM, "active_season",    "",        0,  255, 0) \
+    X(WIFI_OK,          wifiOK,                1,                BOOL, "wifi_ok",          "",        0,    1, 0) \
+    /* Combustion / boiler settings */ \
+    X(EXHAUST_SETPOINT, exhaustSetpoint,       1,                I32,  "setpoint",         "F",     200,  900, 0) \
+    X(CLAMP_MIN,        clampMinPercent,       1,                I32,  "fan_min",          "%",       0,  100, 0) \
+    X(CLAMP_MAX,        clampMaxPercent,       1,                I32,  "fan_max",          "%",       0,  100, 0) \
+    X(DEADBAND,         deadbandF,             1,                I32,  "deadband",         "F",       1,  100, 0) \
+    X(DEADZONE_MODE,    deadzoneFanMode,       1,                U8,   "deadzone",         "",        0,    1, 0) \
+    X(BOOST_TIME,       boostTimeSeconds,      1,                I32,  "boost_sec",        "s",       5,  600, 0) \
+    X(GUARDIAN_MINUTES, emberGuardianTimerMinutes, 1,            I32,  "ember_min",        "min",     1,  120, 0) \
+    X(FLUE_LOW,         flueLowThreshold,      1,                I16,  "flue_low",         "F",      50,  500, 0) \
+    X(FLUE_RECOVERY,    flueRecoveryThreshold, 1,                I16,  "flue_rec",         "F",      50,  500, 0) \
+    X(TANK_LOW,         tankLowSetpointF,      1,                I16,  "tank_low",         "F",      60,  200, 0) \
+    X(TANK_HIGH,        tankHighSetpointF,     1,                I16,  "tank_high",        "F",      80,  210, 0) \
+    X(CONTROL_MODE,     controlMode,           1,                ENUM, "control_mode",     "",        0,    1, 0) \
+    /* Environmental settings */ \
+    X(SEASON_MODE,      envSeasonMode,         1,                U8,   "season_mode",      "",        0,    2, 0) \
+    X(AUTO_SEASON,      envAutoSeasonEnabled,  1,                BOOL, "auto_season",      "",        0,    1, 0) \
+    X(LOCKOUT_SEC,      envModeLockoutSec,     1,                U32,  "lockout_sec",      "s",       0, 356400, 0) \
+    X(SUMMER_START,     envSummerStartF,       1,                I16,  "summer_start",     "F",     -50,  120, 0) \
+    X(SPF_START,        envSpringFallStartF,   1,                I16,  "spf_start",        "F",     -50,  120, 0) \
+    X(WINTER_START,     envWinterStartF,       1,                I16,  "winter_start",     "F",     -50,  120, 0) \
+    X(EXTREME_START,    envExtremeStartF,      1,                I16,  "extreme_start",    "F",     -50,  120, 0) \
+    X(SUMMER_BUFFER,    envHystSummerF,        1,                I16,  "summer_buffer",    "F",       0,   50, 0) \
+    X(SPF_BUFFER,       envHystSpringFallF,    1,                I16,  "spf_buffer",       "F",       0,   50, 0) \
+    X(WINTER_BUFFER,    envHystWinterF,        1,                I16,  "winter_buffer",    "F",       0,   50, 0) \
+    X(EXTREME_BUFFER,   envHystExtremeF,       1,                I16,  "extreme_buffer",   "F",       0,   50, 0) \
+    X(SUMMER_SETPOINT,  envSetpointSummerF,    1,                I16,  "summer_setpoint",  "F",     200,  900, 0) \
+    X(SPF_SETPOINT,     envSetpointSpringFallF, 1,               I16,  "spf_setpoint",     "F",     200,  900, 0) \
+    X(WINTER_SETPOINT,  envSetpointWinterF,    1,                I16,  "winter_setpoint",  "F",     200,  900, 0) \
+    X(EXTREME_SETPOINT, envSetpointExtremeF,   1,                I16,  "extreme_setpoint", "F",     200,  900, 0) \
+    X(SUMMER_TANK_HIGH, envTankHighSummerF,    1,                I16,  "summer_tank_high", "F",      80,  210, 0) \
+    X(SPF_TANK_HIGH,    envTankHighSpringFallF, 1,               I16,  "spf_tank_high",    "F",      80,  210, 0) \
+    X(WINTER_TANK_HIGH, envTankHighWinterF,    1,                I16,  "winter_tank_high", "F",      80,  210, 0) \
+    X(EXTREME_TANK_HIGH, envTankHighExtremeF,  1,                I16,  "extreme_tank_high", "F",     80,  210, 0) \
+    X(SUMMER_TANK_LOW,  envTankLowSummerF,     1,                I16,  "summer_tank_low",  "F",      60,  200, 0) \
+    X(SPF_TANK_LOW,     envTankLowSpringFallF, 1,                I16,  "spf_tank_low",     "F",      60,  200, 0) \
+    X(WINTER_TANK_LOW,  envTankLowWinterF,     1,                I16,  "winter_tank_low",  "F",      60,  200, 0) \
+    X(EXTREME_TANK_LOW, envTankLowExtremeF,    1,                I16,  "extreme_tank_low", "F",      60,  200, 0) \
+    X(SUMMER_CLAMP_MAX, envClampMaxSummerPercent,     1,         U8,   "summer_clamp_max", "%",       0,  100, 0) \
+    X(SPF_CLAMP_MAX,    envClampMaxSpringFallPercent, 1,         U8,   "spf_clamp_max",    "%",       0,  100, 0) \
+    X(WINTER_CLAMP_MAX, envClampMaxWinterPercent,     1,         U8,   "winter_clamp_max", "%",       0,  100, 0) \
+    X(EXTREME_CLAMP_MAX, envClampMaxExtremePercent,   1,         U8,   "extreme_clamp_max", "%",      0,  100, 0)
+
+/* ============================================================
+ *  GENERATED IDS / MASKS
+ * ============================================================ */
+enum SysField : uint8_t {
+#define SYSF_ENUM(id, member, count, type, key, unit, lo, hi, res) SF_##id,
+    SYSF_FIELDS(SYSF_ENUM)
+#undef SYSF_ENUM
+    SF_COUNT
+};
+
+typedef uint64_t SysFieldMask;
+
+#define SF_BIT(id)   ((SysFieldMask)1 << (SF_##id))
+#define SF_ALL       (SF_COUNT >= 64 ? ~(SysFieldMask)0 : (((SysFieldMask)1 << SF_COUNT) - 1))
+
+// Groups used by consumers
+#define SF_MASK_WATER     (SF_BIT(WATER_COUNT) | SF_BIT(WATER_TEMP) | SF_BIT(PROBE_ROLES))
+#define SF_MASK_OUTDOOR   (SF_BIT(ENV_OK) | SF_BIT(ENV_TEMP) | SF_BIT(ENV_HUMIDITY) | SF_BIT(ENV_PRESSURE))
+#define SF_MASK_GUARDIAN  (SF_BIT(GUARDIAN_ACTIVE) | SF_BIT(GUARDIAN_LATCHED) | SF_BIT(GUARDIAN_TIMER))
+#define SF_MASK_STATE     (SF_BIT(EXHAUST_SMOOTH) | SF_BIT(EXHAUST_OK) | SF_BIT(FAN_FINAL) | \
+                           SF_BIT(BURN_STATE) | SF_BIT(SAFETY_STATE) | SF_MASK_GUARDIAN | \
+                           SF_BIT(CONTROL_MODE) | SF_BIT(TANK_LOW) | SF_BIT(TANK_HIGH))
+#define SF_MASK_SETTINGS  (SF_ALL & ~(SF_BIT(EXHAUST_SETPOINT) - 1))   // EXHAUST_SETPOINT onward
+
+enum SysFieldType : uint8_t {
+    SFT_BOOL, SFT_U8, SFT_I16, SFT_I32, SFT_U32, SFT_F32, SFT_ENUM
+};
+
+struct SysFieldInfo {
+    const char* key;
+    const char* unit;
+    uint16_t    offset;     // into SystemData
+    uint8_t     type;       // SysFieldType
+    uint8_t     count;      // array elements
+    uint8_t     size;       // bytes per element
+    float       minVal;
+    float       maxVal;
+    float       res;
+};
+
+/* ============================================================
+ *  CONSUMERS
+ * ============================================================ */
+enum SysConsumer : uint8_t {
+    SYSF_UI = 0,
+    SYSF_MQTT,
+    SYSF_LORA,
+    SYSF_CONSUMER_COUNT
+};
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Shadow = current sys, every consumer starts with all fields dirty
+void sysf_init();
+
+const SysFieldInfo* sysf_info(SysField f);
+
+// Typed setters: clamp to [min, max] (NaN passes through), write,
+// and mark dirty on change. Return true if the field changed.
+bool sysf_setF(SysField f, float v, uint8_t idx = 0);
+bool sysf_setI(SysField f, int32_t v, uint8_t idx = 0);
+
+// Current value as float / int (ints, enums, bools)
+float   sysf_getF(SysField f, uint8_t idx = 0);
+int32_t sysf_getI(SysField f, uint8_t idx = 0);
+
+// Mark a field dirty for every consumer (e.g. forced republish)
+void sysf_touch(SysField f);
+
+// Compare all fields against the shadow and mark changes
+void sysf_sync();
+
+// Sync, then return and clear this consumer's dirty mask
+SysFieldMask sysf_take(SysConsumer c);
+
+#endif
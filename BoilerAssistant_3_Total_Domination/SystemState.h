@@ -18,6 +18,7 @@
  *      • Environmental seasons
  *      • UI state machine
  *      • Probe roles
+ *      • Thermocouple channels
  *
  *    Architectural Notes:
  *      - No logic belongs here — only enums and constants.
@@ -44,6 +45,8 @@
 #define PROBE_ROLE_COUNT 8
 #endif
 
+#define TC_CHANNELS 4
+
 /* ============================================================
  *  PROBE ROLE ENUM
  * ============================================================ */
@@ -58,6 +61,16 @@ typedef enum {
     PROBE_UNUSED_7   = 7
 } ProbeRole;
 
+/* ============================================================
+ *  THERMOCOUPLE CHANNELS (MAX31855, TC1..TC4)
+ * ============================================================ */
+typedef enum {
+    TC_EXHAUST        = 0,
+    TC_SECONDARY_FLUE = 1,
+    TC_HEAT_EXCHANGER = 2,
+    TC_FIREBOX        = 3
+} TcChannel;
+
 /* ============================================================
  *  BURN ENGINE STATES
  * ============================================================ */
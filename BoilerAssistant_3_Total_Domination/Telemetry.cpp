@@ -0,0 +1,113 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Telemetry Snapshot (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Telemetry.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Seqlock‑protected double buffer behind Telemetry.h.
+ *
+ *  Architectural Notes:
+ *      - __sync_synchronize() orders the buffer writes before the
+ *        seq store (DMB on Cortex‑M, full fence on the host)
+ *      - No allocation; two snapshots (~190 bytes each) in .bss
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "Telemetry.h"
+#include "SystemData.h"
+
+extern SystemData sys;
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static TelemetrySnapshot  buf[2];
+static volatile uint32_t  seq = 0;
+
+// Per‑buffer stamp, accessed volatile so the recheck is a real load
+static inline volatile uint32_t& bufSeq(uint32_t i) {
+    return *(volatile uint32_t*)&buf[i & 1].seq;
+}
+
+/* ============================================================
+ *  WRITER
+ * ============================================================ */
+void telemetry_capture(unsigned long now) {
+    uint32_t next = seq + 1;
+    TelemetrySnapshot& s = buf[next & 1];
+
+    // Invalidate first: a reader still copying this buffer sees 0
+    bufSeq(next & 1) = 0;
+    __sync_synchronize();
+
+    s.takenMs = now;
+
+    s.exhaustOK         = sys.exhaustSensorOK;
+    s.exhaustF          = sys.exhaustSmoothF;
+    s.exhaustRawF       = sys.exhaustRawF;
+    s.fanPercent        = sys.fanFinal;
+    s.burnState         = sys.burnState;
+    s.safetyState       = sys.safetyState;
+    s.controlMode       = sys.controlMode;
+
+    s.exhaustSetpoint   = sys.exhaustSetpoint;
+    s.tankLowSetpointF  = sys.tankLowSetpointF;
+    s.tankHighSetpointF = sys.tankHighSetpointF;
+
+    s.waterProbeCount   = sys.waterProbeCount;
+    s.tankProbe         = (sys.probeRoleMap[PROBE_TANK] < sys.waterProbeCount)
+                          ? sys.probeRoleMap[PROBE_TANK] : 0;
+    memcpy(s.waterTempF, sys.waterTempF, sizeof(s.waterTempF));
+
+    memcpy(s.tcTempF,         sys.tcTempF,         sizeof(s.tcTempF));
+    memcpy(s.tcColdJunctionF, sys.tcColdJunctionF, sizeof(s.tcColdJunctionF));
+    memcpy(s.tcFault,         sys.tcFault,         sizeof(s.tcFault));
+
+    s.envOK             = sys.envSensorOK;
+    s.envTempF          = sys.envTempF;
+    s.envHumidity       = sys.envHumidity;
+    s.envPressure       = sys.envPressure;
+
+    s.guardianActive       = sys.emberGuardianActive;
+    s.guardianLatched      = sys.emberGuardianLatched;
+    s.guardianTimerActive  = sys.emberGuardianTimerActive;
+    s.guardianTimerMinutes = sys.emberGuardianTimerMinutes;
+    s.guardianStartMs      = sys.emberGuardianStartMs;
+    s.boostStartMs         = sys.boostStartMs;
+    s.rampStartMs          = sys.rampStartMs;
+    s.holdStartMs          = sys.holdStartMs;
+
+    __sync_synchronize();
+    bufSeq(next & 1) = next;
+    __sync_synchronize();
+    seq = next;
+}
+
+/* ============================================================
+ *  READERS
+ * ============================================================ */
+uint32_t telemetry_read(TelemetrySnapshot* out) {
+    uint32_t s;
+
+    do {
+        s = seq;
+        __sync_synchronize();
+        memcpy(out, &buf[s & 1], sizeof(TelemetrySnapshot));
+        __sync_synchronize();
+    } while (s != 0 && bufSeq(s) != s);   // writer reused our buffer
+
+    out->seq = s;
+
+    return s;
+}
+
+uint32_t telemetry_seq() {
+    return seq;
+}
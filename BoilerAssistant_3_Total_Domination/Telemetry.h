@@ -0,0 +1,100 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Telemetry Snapshot API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Telemetry.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Consistent, versioned copy of the telemetry‑relevant part of
+ *    SystemData, taken at the end of every control step (and after
+ *    the tasks that change telemetry between steps: water probe,
+ *    outdoor sensor and keypad).
+ *    Outward‑facing modules (MQTT, HTTP API, LoRa, home screen)
+ *    serialize from a snapshot, so a message can never mix a burn
+ *    state from before a transition with a fan value from after.
+ *
+ *    Double‑buffered seqlock:
+ *      writer  zeroes buf[n & 1].seq (n = seq + 1), fills the
+ *              buffer, stamps buf[n & 1].seq = n, publishes seq = n
+ *      reader  copies buf[s & 1] for s = seq, then retries unless
+ *              that buffer's own seq still reads s (a capture that
+ *              reused it has cleared or restamped it)
+ *
+ *    The writer never waits, and readers only retry if they are
+ *    preempted for a whole control period. The scheme holds for
+ *    a future ISR or second‑core reader as well.
+ *
+ *  Architectural Notes:
+ *      - telemetry_capture() is the only writer; it is called at
+ *        task boundaries, never in the middle of a step
+ *      - Only the setpoints shown next to live values are copied;
+ *        the settings payloads still read sys directly
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "SystemState.h"
+
+struct TelemetrySnapshot {
+    uint32_t      seq;              // version, odd/even alternates buffers
+    unsigned long takenMs;
+
+    /* Combustion */
+    bool          exhaustOK;
+    float         exhaustF;         // filtered
+    float         exhaustRawF;
+    int           fanPercent;
+    BurnState     burnState;
+    SafetyState   safetyState;
+    RunMode       controlMode;
+
+    int           exhaustSetpoint;
+    int16_t       tankLowSetpointF;
+    int16_t       tankHighSetpointF;
+
+    /* Water */
+    uint8_t       waterProbeCount;
+    uint8_t       tankProbe;        // physical index for PROBE_TANK
+    float         waterTempF[MAX_WATER_PROBES];
+
+    /* Thermocouples */
+    float         tcTempF[TC_CHANNELS];
+    float         tcColdJunctionF[TC_CHANNELS];
+    uint8_t       tcFault[TC_CHANNELS];
+
+    /* Outdoor */
+    bool          envOK;
+    float         envTempF;
+    float         envHumidity;
+    float         envPressure;
+
+    /* Ember Guardian / phase timers */
+    bool          guardianActive;
+    bool          guardianLatched;
+    bool          guardianTimerActive;
+    int           guardianTimerMinutes;
+    unsigned long guardianStartMs;
+    unsigned long boostStartMs;
+    unsigned long rampStartMs;
+    unsigned long holdStartMs;
+};
+
+// Copy the telemetry fields of sys into the next buffer and publish
+void telemetry_capture(unsigned long now);
+
+// Copy the latest snapshot. Returns its seq (0 = none captured yet).
+uint32_t telemetry_read(TelemetrySnapshot* out);
+
+// Latest published version without copying
+uint32_t telemetry_seq();
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Offline Telemetry History (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: TelemetryHistory.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Packed RAM ring (plus optional EEPROM spill ring) behind
+ *    TelemetryHistory.h. Ordering is always spill (older) first,
+ *    then RAM.
+ *
+ *  Architectural Notes:
+ *      - Runs in the network task only; no ISR access
+ *      - Spill writes happen at most once per HISTORY_PERIOD_MS
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "TelemetryHistory.h"
+#include "Telemetry.h"
+
+#if HISTORY_SPILL_EEPROM
+#include <EEPROM.h>
+#endif
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static HistorySample ring[HISTORY_CAPACITY];
+static uint16_t      head  = 0;            // oldest
+static uint16_t      count = 0;
+
+static unsigned long lastSampleMs = 0;
+static bool          sampledOnce  = false;
+static uint32_t      overflows    = 0;
+
+#if HISTORY_SPILL_EEPROM
+static uint16_t      spillHead  = 0;
+static uint16_t      spillCount = 0;
+
+static int spillAddr(uint16_t slot) {
+    return HISTORY_SPILL_BASE + (int)slot * (int)sizeof(HistorySample);
+}
+#endif
+
+/* ============================================================
+ *  PACKING
+ * ============================================================ */
+static HistorySample pack(const TelemetrySnapshot& t, unsigned long now) {
+    HistorySample s;
+
+    s.minute = (uint16_t)(now / 60000UL);
+
+    s.exhaustF = (t.exhaustOK && !isnan(t.exhaustF))
+                 ? (int16_t)lroundf(t.exhaustF) : HISTORY_NO_VALUE;
+
+    float tank = (t.waterProbeCount > 0) ? t.waterTempF[t.tankProbe] : NAN;
+    s.tankF10 = isnan(tank) ? HISTORY_NO_VALUE : (int16_t)lroundf(tank * 10.0f);
+
+    if (t.envOK && !isnan(t.envTempF)) {
+        long o = lroundf(t.envTempF) + 64;
+        s.outdoorF = (uint8_t)constrain(o, 0L, 254L);
+    } else {
+        s.outdoorF = 0xFF;
+    }
+
+    s.fan = (uint8_t)constrain(t.fanPercent, 0, 100);
+
+    s.flags = (uint8_t)(t.burnState & 0x07)
+            | (uint8_t)((t.safetyState & 0x03) << 3)
+            | (t.guardianActive ? HISTORY_FLAG_GUARDIAN   : 0)
+            | (t.exhaustOK      ? HISTORY_FLAG_EXHAUST_OK : 0)
+            | (t.envOK          ? HISTORY_FLAG_OUTDOOR_OK : 0);
+
+    return s;
+}
+
+/* ============================================================
+ *  RING
+ * ============================================================ */
+static void push(const HistorySample& s) {
+    if (count == HISTORY_CAPACITY) {
+#if HISTORY_SPILL_EEPROM
+        // Oldest RAM sample moves to flash instead of being lost
+        if (spillCount == HISTORY_SPILL_SLOTS) {
+            spillHead = (spillHead + 1) % HISTORY_SPILL_SLOTS;
+            spillCount--;
+            overflows++;
+        }
+        uint16_t slot = (spillHead + spillCount) % HISTORY_SPILL_SLOTS;
+        EEPROM.put(spillAddr(slot), ring[head]);
+        spillCount++;
+#else
+        overflows++;
+#endif
+        head = (head + 1) % HISTORY_CAPACITY;
+        count--;
+    }
+
+    ring[(head + count) % HISTORY_CAPACITY] = s;
+    count++;
+}
+
+/* ============================================================
+ *  PUBLIC API
+ * ============================================================ */
+void history_poll(unsigned long now, bool online) {
+    if (online) {
+        sampledOnce = false;          // next outage samples immediately
+        return;
+    }
+
+    if (sampledOnce && now - lastSampleMs < HISTORY_PERIOD_MS) return;
+
+    TelemetrySnapshot t;
+    if (telemetry_read(&t) == 0) return;   // nothing captured yet
+
+    push(pack(t, now));
+
+    lastSampleMs = now;
+    sampledOnce  = true;
+}
+
+uint16_t history_count() {
+#if HISTORY_SPILL_EEPROM
+    return count + spillCount;
+#else
+    return count;
+#endif
+}
+
+uint8_t history_peek(HistorySample* out, uint8_t max) {
+    uint8_t n = 0;
+
+#if HISTORY_SPILL_EEPROM
+    for (uint16_t i = 0; i < spillCount && n < max; i++, n++) {
+        EEPROM.get(spillAddr((spillHead + i) % HISTORY_SPILL_SLOTS), out[n]);
+    }
+#endif
+
+    for (uint16_t i = 0; i < count && n < max; i++, n++) {
+        out[n] = ring[(head + i) % HISTORY_CAPACITY];
+    }
+
+    return n;
+}
+
+void history_drop(uint8_t n) {
+#if HISTORY_SPILL_EEPROM
+    while (n && spillCount) {
+        spillHead = (spillHead + 1) % HISTORY_SPILL_SLOTS;
+        spillCount--;
+        n--;
+    }
+#endif
+
+    if (n > count) n = count;
+    head   = (head + n) % HISTORY_CAPACITY;
+    count -= n;
+}
+
+uint32_t history_overflows() {
+    return overflows;
+}
@@ -0,0 +1,102 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Offline Telemetry History API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: TelemetryHistory.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Store‑and‑forward buffer for telemetry taken after the MQTT
+ *    link was lost, or while the AP portal runs. One packed
+ *    9‑byte sample per HISTORY_PERIOD_MS goes into a fixed RAM
+ *    ring; MQTTClient drains it to boiler/history after
+ *    reconnect, oldest first.
+ *
+ *    Sample layout (packed, little‑endian):
+ *      minute     u16  uptime minutes when taken (mod 65536)
+ *      exhaustF   i16  whole °F, HISTORY_NO_VALUE if invalid
+ *      tankF10    i16  tenths °F, HISTORY_NO_VALUE if invalid
+ *      outdoorF   u8   °F + 64 (‑64..190), 0xFF if invalid
+ *      fan        u8   %
+ *      flags      u8   burn state [2:0], safety [4:3],
+ *                      Guardian active [5], exhaust OK [6],
+ *                      outdoor OK [7]
+ *
+ *    Optional spill (HISTORY_SPILL_EEPROM): when the RAM ring is
+ *    full the oldest sample moves to a second ring in the upper
+ *    half of the data‑flash EEPROM instead of being dropped. The
+ *    spill is volatile by design — uptime stamps restart at boot,
+ *    so it is discarded on reset.
+ *
+ *  Architectural Notes:
+ *      - No allocation; HISTORY_CAPACITY × 9 bytes of .bss
+ *      - Samples come from the telemetry snapshot (Telemetry.h)
+ *      - Serialization stays in MQTTClient.cpp
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <Arduino.h>
+
+/* ============================================================
+ *  CONFIGURATION
+ * ============================================================ */
+#define HISTORY_PERIOD_MS      60000UL   // 1‑minute resolution
+#define HISTORY_CAPACITY       720       // 12 h in RAM (6480 bytes)
+
+#ifndef HISTORY_SPILL_EEPROM
+#define HISTORY_SPILL_EEPROM   0         // 1 = overflow into data flash
+#endif
+#define HISTORY_SPILL_BASE     4096      // upper half of the 8 KB EEPROM
+#define HISTORY_SPILL_SLOTS    455       // +7.5 h
+
+#define HISTORY_NO_VALUE       ((int16_t)-32768)
+
+/* ============================================================
+ *  SAMPLE
+ * ============================================================ */
+struct __attribute__((packed)) HistorySample {
+    uint16_t minute;
+    int16_t  exhaustF;
+    int16_t  tankF10;
+    uint8_t  outdoorF;
+    uint8_t  fan;
+    uint8_t  flags;
+};
+
+static_assert(sizeof(HistorySample) == 9, "HistorySample must stay packed");
+
+#define HISTORY_FLAG_BURN(f)        ((f) & 0x07)
+#define HISTORY_FLAG_SAFETY(f)      (((f) >> 3) & 0x03)
+#define HISTORY_FLAG_GUARDIAN       0x20
+#define HISTORY_FLAG_EXHAUST_OK     0x40
+#define HISTORY_FLAG_OUTDOOR_OK     0x80
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Record one sample per period while online is false (called from
+// task_network with !mqtt_outage(), in every provisioning state)
+void history_poll(unsigned long now, bool online);
+
+// Samples waiting to be forwarded (RAM + spill)
+uint16_t history_count();
+
+// Copy up to max oldest samples without removing them
+uint8_t history_peek(HistorySample* out, uint8_t max);
+
+// Remove n oldest samples after they were published
+void history_drop(uint8_t n);
+
+// Samples lost to overflow since boot
+uint32_t history_overflows();
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Thermocouple Module (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Thermocouples.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Reads the four MAX31855 amplifiers with one hardware SPI
+ *    transaction each and decodes the frame in place. Replaces
+ *    the Adafruit_MAX31855 software‑SPI driver, which bit‑banged
+ *    every clock edge and re‑read the frame for each value.
+ *
+ *  Architectural Notes:
+ *      - SPI mode 0, MSB first, TC_SPI_HZ; the bus is shared, so
+ *        each frame is wrapped in begin/endTransaction
+ *      - The MAX31855 converts continuously (~100 ms); reading a
+ *        channel faster only returns the same value
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "Thermocouples.h"
+#include "SystemData.h"
+#include "Pinout.h"
+
+#include <SPI.h>
+
+extern SystemData sys;
+
+/* ============================================================
+ *  CHANNEL TABLE
+ * ============================================================ */
+static const uint8_t tcCsPin[TC_CHANNELS] = {
+    PIN_TC1_CS,
+    PIN_TC2_CS,
+    PIN_TC3_CS,
+    PIN_TC4_CS
+};
+
+static bool    tcEnabled[TC_CHANNELS];
+static uint8_t tcNextSecondary = TC_SECONDARY_FLUE;
+
+static const SPISettings tcSpi(TC_SPI_HZ, MSBFIRST, SPI_MODE0);
+
+/* ============================================================
+ *  DECODE
+ * ============================================================ */
+bool tc_decode(uint32_t frame, float* tempC, float* coldJunctionC,
+               uint8_t* fault)
+{
+    // Cold junction: D15..D4, sign‑extended via arithmetic shift
+    int16_t cj = (int16_t)(frame & 0xFFFF) >> 4;
+    *coldJunctionC = cj * 0.0625f;
+
+    if (frame == 0 || frame == 0xFFFFFFFFUL) {
+        *fault  = TC_FAULT_BUS;
+        *tempC  = NAN;
+        *coldJunctionC = NAN;
+        return false;
+    }
+
+    if (frame & 0x00010000UL) {
+        *fault = (uint8_t)(frame & 0x07);
+        *tempC = NAN;
+        return false;
+    }
+
+    // Thermocouple: D31..D18
+    int32_t tc = (int32_t)frame >> 18;
+    *tempC = tc * 0.25f;
+    *fault = 0;
+    return true;
+}
+
+/* ============================================================
+ *  BUS ACCESS
+ * ============================================================ */
+static uint32_t readFrame(uint8_t pin) {
+    uint32_t frame = 0;
+
+    SPI.beginTransaction(tcSpi);
+    digitalWrite(pin, LOW);
+    for (uint8_t i = 0; i < 4; i++) {
+        frame = (frame << 8) | SPI.transfer(0x00);
+    }
+    digitalWrite(pin, HIGH);
+    SPI.endTransaction();
+
+    return frame;
+}
+
+/* ============================================================
+ *  INIT
+ * ============================================================ */
+void tc_init() {
+    SPI.begin();
+
+    for (uint8_t ch = 0; ch < TC_CHANNELS; ch++) {
+        uint8_t pin = tcCsPin[ch];
+
+        sys.tcTempF[ch]         = NAN;
+        sys.tcColdJunctionF[ch] = NAN;
+
+        if (pin == PIN_FAN_PWM || pin == PIN_DAMPER) {
+            tcEnabled[ch]  = false;
+            sys.tcFault[ch] = TC_FAULT_DISABLED;
+            Serial.print(F("TC"));
+            Serial.print(ch + 1);
+            Serial.println(F(": CS pin shared with an output, disabled"));
+            continue;
+        }
+
+        tcEnabled[ch]   = true;
+        sys.tcFault[ch] = 0;
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, HIGH);
+    }
+}
+
+bool tc_enabled(uint8_t ch) {
+    return ch < TC_CHANNELS && tcEnabled[ch];
+}
+
+/* ============================================================
+ *  SAMPLE
+ * ============================================================ */
+bool tc_sample(uint8_t ch) {
+    if (!tc_enabled(ch)) return false;
+
+    float c, cj;
+    uint8_t fault;
+    bool ok = tc_decode(readFrame(tcCsPin[ch]), &c, &cj, &fault);
+
+    sys.tcFault[ch]         = fault;
+    sys.tcColdJunctionF[ch] = cj * 9.0f / 5.0f + 32.0f;
+    sys.tcTempF[ch]         = ok ? c * 9.0f / 5.0f + 32.0f : NAN;
+    return ok;
+}
+
+uint8_t tc_pollSecondary() {
+    for (uint8_t n = 0; n < TC_CHANNELS - 1; n++) {
+        uint8_t ch = tcNextSecondary;
+
+        tcNextSecondary++;
+        if (tcNextSecondary >= TC_CHANNELS) tcNextSecondary = TC_SECONDARY_FLUE;
+
+        if (tcEnabled[ch]) {
+            tc_sample(ch);
+            return ch;
+        }
+    }
+    return TC_CHANNELS;
+}
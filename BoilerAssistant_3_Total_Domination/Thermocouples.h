@@ -0,0 +1,77 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Thermocouple API (v3.0 "Total Domination")
+ *  ------------------------------------------------------------
+ *  File: Thermocouples.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Multi‑channel MAX31855 acquisition on the hardware SPI bus.
+ *    One 32‑bit frame per channel carries everything we need:
+ *
+ *      D31..D18  thermocouple °C, signed 14‑bit, 0.25 °C/LSB
+ *      D16       fault (any)
+ *      D15..D4   cold junction °C, signed 12‑bit, 0.0625 °C/LSB
+ *      D2..D0    SCV / SCG / OC fault bits
+ *
+ *    Channels:
+ *      TC1  exhaust (feeds the exhaust filter, every poll)
+ *      TC2  secondary flue     ┐
+ *      TC3  heat exchanger     ├ round‑robin, one per poll
+ *      TC4  firebox            ┘
+ *
+ *  Architectural Notes:
+ *      - Results land in sys.tcTempF[] / tcColdJunctionF[] / tcFault[]
+ *      - A channel whose CS pin is shared with an actuator output
+ *        (PIN_FAN_PWM, PIN_DAMPER) is disabled at init
+ *      - tc_decode() is pure and usable on the host
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef THERMOCOUPLES_H
+#define THERMOCOUPLES_H
+
+#include <Arduino.h>
+#include "SystemState.h"
+
+/* ============================================================
+ *  FAULT BITS (sys.tcFault[])
+ * ============================================================ */
+#define TC_FAULT_OPEN       0x01   // OC:  probe open circuit
+#define TC_FAULT_SHORT_GND  0x02   // SCG: shorted to GND
+#define TC_FAULT_SHORT_VCC  0x04   // SCV: shorted to VCC
+#define TC_FAULT_BUS        0x40   // frame all 0s / all 1s (no chip)
+#define TC_FAULT_DISABLED   0x80   // channel not wired / pin conflict
+
+// MAX31855 allows 5 MHz SCK
+#ifndef TC_SPI_HZ
+#define TC_SPI_HZ 4000000UL
+#endif
+
+/* ============================================================
+ *  API
+ * ============================================================ */
+
+// Configure SPI and chip selects, mark conflicting channels disabled
+void tc_init();
+
+// Read one channel into SystemData. Returns true on a valid reading.
+bool tc_sample(uint8_t ch);
+
+// Read the next enabled secondary channel (TC2..TC4).
+// Returns the channel read, or TC_CHANNELS when none are enabled.
+uint8_t tc_pollSecondary();
+
+bool tc_enabled(uint8_t ch);
+
+// Decode a raw MAX31855 frame. Returns false when a fault is flagged;
+// the cold junction value is valid either way.
+bool tc_decode(uint32_t frame, float* tempC, float* coldJunctionC,
+               uint8_t* fault);
+
+#endif
@@ -24,6 +24,11 @@
  *      - All EEPROM writes are delegated to EEPROMStorage.
  *      - Rendering is strictly 20×4 LCD, deterministic, no animations
  *        except the boot sequence.
+ *      - lcd4() goes through the LcdFrame shadow buffer, so only
+ *        changed characters reach the I²C backpack.
+ *      - ui_update() renders only on a key press, a change in a
+ *        SystemFields field the screen shows, or a live screen,
+ *        at ≤ UI_MAX_FPS.
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -37,6 +42,9 @@
 #include "EnvironmentalLogic.h"
 #include "WiFiProvisioning.h"
 #include "RuntimeCredentials.h"
+#include "LcdFrame.h"
+#include "SystemFields.h"
+#include "Telemetry.h"
 #include <LiquidCrystal_PCF8574.h>
 #include <Arduino.h>
 #include <WiFiS3.h>
@@ -149,23 +157,18 @@ static uint8_t selectedPhys = 0;
 
 /* ============================================================
  *  LCD RENDERER
+ *  ------------------------------------------------------------
+ *  Screens describe the whole frame; LcdFrame sends only the
+ *  changed characters, within LCD_FRAME_BUDGET per call.
  * ============================================================ */
 static LiquidCrystal_PCF8574* lcdRef = nullptr;
 
 static void lcd4(const char* l1, const char* l2, const char* l3, const char* l4) {
-    static char last[4][21] = {"", "", "", ""};
-    const char* lines[4] = { l1, l2, l3, l4 };
-
-    for (int i = 0; i < 4; i++) {
-        if (strncmp(lines[i], last[i], 20) != 0) {
-            lcdRef->setCursor(0, i);
-            lcdRef->print("                    ");
-            lcdRef->setCursor(0, i);
-            lcdRef->print(lines[i]);
-            strncpy(last[i], lines[i], 20);
-            last[i][20] = '\0';
-        }
-    }
+    lcdframe_setLine(0, l1);
+    lcdframe_setLine(1, l2);
+    lcdframe_setLine(2, l3);
+    lcdframe_setLine(3, l4);
+    lcdframe_flush();
 }
 
 /* ============================================================
@@ -186,15 +189,37 @@ static void ui_showSafetyLockout(int tankF)
 
 /* ============================================================
  *  BOOT SCREEN
+ *  ------------------------------------------------------------
+ *  Stepped from ui_update() so control runs underneath it. Steps
+ *  are timed from the splash start, not from the pass that drew
+ *  them: the UI task runs every 1000/UI_MAX_FPS ms, slower than
+ *  the 70 ms bar steps, so one pass may catch up several steps.
+ *  Bar frames overwrite the same row; only the newest is drawn.
  * ============================================================ */
-static void showBootScreen() {
-    lcdRef->clear();
-    lcdRef->setCursor(0, 0); lcdRef->print("  BOILER ASSISTANT  ");
-    delay(300);
-    lcdRef->setCursor(0, 1); lcdRef->print("    INITIALIZING    ");
-    delay(300);
-
-    const char* bar[] = {
+#define BOOT_BAR_STEPS 21
+#define BOOT_BAR_FIRST 2                // steps 0/1 are the title lines
+
+static uint8_t       bootStep   = 0;
+static bool          bootActive = false;
+static unsigned long bootNextMs = 0;
+
+// How long step n stays up (0 = splash finished)
+static unsigned long bootHoldMs(uint8_t n) {
+    if (n < BOOT_BAR_FIRST) return 300;
+    n -= BOOT_BAR_FIRST;
+    if (n < BOOT_BAR_STEPS) return 70;
+    n -= BOOT_BAR_STEPS;
+    if (n == 0) return 800;
+    if (n == 1) return 700;
+    return 0;
+}
+
+static bool bootIsBar(uint8_t n) {
+    return n >= BOOT_BAR_FIRST && n < BOOT_BAR_FIRST + BOOT_BAR_STEPS;
+}
+
+static void showBootStep(uint8_t n) {
+    static const char* const bar[BOOT_BAR_STEPS] = {
         "                    ","#                   ","##                  ",
         "###                 ","####                ","#####               ",
         "######              ","#######             ","########            ",
@@ -204,22 +229,61 @@ static void showBootScreen() {
         "##################  ","################### ","********************"
     };
 
-    for (int i = 0; i < 21; i++) {
+    if (n == 0) {
+        lcdRef->clear();
+        lcdRef->setCursor(0, 0); lcdRef->print("  BOILER ASSISTANT  ");
+        return;
+    }
+    if (n == 1) {
+        lcdRef->setCursor(0, 1); lcdRef->print("    INITIALIZING    ");
+        return;
+    }
+    n -= BOOT_BAR_FIRST;
+    if (n < BOOT_BAR_STEPS) {
         lcdRef->setCursor(0, 2);
-        lcdRef->print(bar[i]);
-        delay(70);
+        lcdRef->print(bar[n]);
+        return;
     }
+    n -= BOOT_BAR_STEPS;
+    if (n == 0) {
+        lcdRef->setCursor(0, 3);
+        lcdRef->print("  SYSTEM CHECK OK   ");
+        return;
+    }
+    if (n == 1) {
+        lcdRef->clear();
+        lcdRef->setCursor(0, 0); lcdRef->print("      LOADING       ");
+        lcdRef->setCursor(0, 1); lcdRef->print("LOGIC, WiFi, SENSORS");
+        lcdRef->setCursor(0, 2); lcdRef->print("  PREPARING SYSTEM  ");
+        lcdRef->setCursor(0, 3); lcdRef->print("        V3.0        ");
+    }
+}
 
-    lcdRef->setCursor(0, 3);
-    lcdRef->print("  SYSTEM CHECK OK   ");
-    delay(800);
+// Advance the splash; true while it still owns the LCD
+static bool bootScreenStep(unsigned long now) {
+    if (!bootActive) return false;
 
-    lcdRef->clear();
-    lcdRef->setCursor(0, 0); lcdRef->print("      LOADING       ");
-    lcdRef->setCursor(0, 1); lcdRef->print("LOGIC, WiFi, SENSORS");
-    lcdRef->setCursor(0, 2); lcdRef->print("  PREPARING SYSTEM  ");
-    lcdRef->setCursor(0, 3); lcdRef->print("        V3.0        ");
-    delay(700);
+    while ((long)(now - bootNextMs) >= 0) {
+        unsigned long holdMs = bootHoldMs(bootStep);
+
+        if (holdMs == 0) {
+            // Boot screen drew behind the framebuffer: first frame redraws all
+            bootActive = false;
+            lcdframe_invalidate();
+            uiNeedRedraw = true;
+            return false;
+        }
+
+        bootNextMs += holdMs;
+
+        // Skip a bar frame the next bar frame is already due to replace
+        bool overtaken = bootIsBar(bootStep) && bootIsBar(bootStep + 1) &&
+                         (long)(now - bootNextMs) >= 0;
+        if (!overtaken) showBootStep(bootStep);
+
+        bootStep++;
+    }
+    return true;
 }
 
 /* ============================================================
@@ -232,19 +296,27 @@ void ui_init() {
     lcd.begin(20, 4);
     lcd.setBacklight(255);
 
-    showBootScreen();
+    lcdframe_init(&lcd);
 
     uiState = UI_HOME;
-    uiNeedRedraw = true;
+
+    // The splash itself is drawn by ui_update()
+    bootStep   = 0;
+    bootNextMs = millis();
+    bootActive = true;
 }
 
 /* ============================================================
  *  HOME SCREEN
  * ============================================================ */
-static void ui_showHome(double exhaustF_unused, int fanPercent) {
+static void ui_showHome(double exhaustF_unused, int fanPercent_unused) {
     char l1[21], l2[21], l3[21], l4[21];
 
-    if (sys.emberGuardianLatched && sys.burnState == BURN_EMBER_GUARD) {
+    // Draw one control step's worth of values (see Telemetry.h)
+    TelemetrySnapshot t;
+    telemetry_read(&t);
+
+    if (t.guardianLatched && t.burnState == BURN_EMBER_GUARD) {
         lcd4(
             "   EMBER GUARDIAN   ",
             "   DAMPER/FAN OFF   ",
@@ -254,34 +326,30 @@ static void ui_showHome(double exhaustF_unused, int fanPercent) {
         return;
     }
 
-    int tankIndex = (sys.probeRoleMap[PROBE_TANK] < sys.waterProbeCount)
-                    ? sys.probeRoleMap[PROBE_TANK]
-                    : 0;
-
-    int tankF = (int)(sys.waterTempF[tankIndex] + 0.5);
+    int tankF = (int)(t.waterTempF[t.tankProbe] + 0.5);
 
-    if (sys.safetyState == SAFETY_HIGHTEMP) {
+    if (t.safetyState == SAFETY_HIGHTEMP) {
         ui_showSafetyLockout(tankF);
         return;
     }
 
     snprintf(l1, 21, "E/SPT:%3dF  W/H:%03dF",
-             sys.exhaustSetpoint, sys.tankHighSetpointF);
+             t.exhaustSetpoint, t.tankHighSetpointF);
 
-    double dispF = sys.exhaustSmoothF;
+    double dispF = t.exhaustF;
 
-    if (!sys.exhaustSensorOK || isnan(dispF))
-        snprintf(l2, 21, "E/CUR:ERR   W/L:%03dF", sys.tankLowSetpointF);
+    if (!t.exhaustOK || isnan(dispF))
+        snprintf(l2, 21, "E/CUR:ERR   W/L:%03dF", t.tankLowSetpointF);
     else
         snprintf(l2, 21, "E/CUR:%3dF  W/L:%03dF",
-                 (int)(dispF + 0.5), sys.tankLowSetpointF);
+                 (int)(dispF + 0.5), t.tankLowSetpointF);
 
-    if (fanPercent <= 0)
+    if (t.fanPercent <= 0)
         snprintf(l3, 21, "FAN:OFF     W/C:%03dF", tankF);
     else
-        snprintf(l3, 21, "FAN:%3d%%    W/C:%03dF", fanPercent, tankF);
+        snprintf(l3, 21, "FAN:%3d%%    W/C:%03dF", t.fanPercent, tankF);
 
-    switch (sys.burnState) {
+    switch (t.burnState) {
         case BURN_IDLE:        snprintf(l4, 21, "IDLE          "); break;
         case BURN_RAMP:        snprintf(l4, 21, "RAMPING UP    "); break;
         case BURN_HOLD:        snprintf(l4, 21, "IN THE ZONE!! "); break;
@@ -290,13 +358,13 @@ static void ui_showHome(double exhaustF_unused, int fanPercent) {
         default:               snprintf(l4, 21, "UNKNOWN       "); break;
     }
 
-    if (!sys.emberGuardianActive &&
-        sys.emberGuardianTimerActive &&
-        sys.emberGuardianTimerMinutes > 0)
+    if (!t.guardianActive &&
+        t.guardianTimerActive &&
+        t.guardianTimerMinutes > 0)
     {
         unsigned long now = millis();
-        unsigned long elapsed = now - sys.emberGuardianStartMs;
-        unsigned long total = (unsigned long)sys.emberGuardianTimerMinutes * 60000UL;
+        unsigned long elapsed = now - t.guardianStartMs;
+        unsigned long total = (unsigned long)t.guardianTimerMinutes * 60000UL;
 
         long remainingMs = (long)total - (long)elapsed;
         if (remainingMs < 0) remainingMs = 0;
@@ -1465,7 +1533,7 @@ case UI_SEASON_EDIT_TANKHIGH:
         if (envSeasonEditValue.length()) {
             int v = envSeasonEditValue.toInt();
             *ui_getSeasonTankHighPtr(uiEditSeason) = v;
-            eeprom_saveEnvSeasonSetpoints();
+            eeprom_saveEnvSeasonTankValues();
         }
         envSeasonEditValue = "";
         uiState = UI_SEASON_DETAIL_MENU_2;
@@ -1487,7 +1555,7 @@ case UI_SEASON_EDIT_TANKLOW:
         if (envSeasonEditValue.length()) {
             int v = envSeasonEditValue.toInt();
             *ui_getSeasonTankLowPtr(uiEditSeason) = v;
-            eeprom_saveEnvSeasonSetpoints();
+            eeprom_saveEnvSeasonTankValues();
         }
         envSeasonEditValue = "";
         uiState = UI_SEASON_DETAIL_MENU_2;
@@ -1511,7 +1579,7 @@ case UI_SEASON_EDIT_CLAMPMAX:
             if (v < 0) v = 0;
             if (v > 100) v = 100;
             *ui_getSeasonClampMaxPtr(uiEditSeason) = (uint8_t)v;
-            eeprom_saveEnvSeasonSetpoints();
+            eeprom_saveEnvSeasonClampValues();
         }
         envSeasonEditValue = "";
         uiState = UI_SEASON_DETAIL_MENU_2;
@@ -1788,3 +1856,85 @@ void ui_showScreen(UIState st, double exhaustF, int fanPercent)
             break;
     }
 }
+
+/* ============================================================
+ *  SCREEN → FIELD RELEVANCE
+ *  ------------------------------------------------------------
+ *  Which SystemFields a screen shows. Menus and edit screens
+ *  show settings only; settings are included everywhere because
+ *  MQTT and the HTTP API change them behind the keypad's back.
+ * ============================================================ */
+static SysFieldMask uiScreenFields(UIState st) {
+    switch (st) {
+        case UI_HOME:
+            return SF_MASK_STATE | SF_MASK_WATER |
+                   SF_BIT(EXHAUST_SETPOINT) | SF_BIT(GUARDIAN_MINUTES);
+        case UI_BME_SCREEN:
+            return SF_MASK_OUTDOOR;
+        case UI_WATER_PROBE_MENU:
+            return SF_MASK_WATER;
+        case UI_SAFETY_STATUS:
+            return SF_BIT(SAFETY_STATE) | SF_MASK_WATER | SF_MASK_SETTINGS;
+        default:
+            return SF_MASK_SETTINGS;
+    }
+}
+
+// Home screen countdown is shown in whole minutes (not a field)
+static int32_t uiGuardianMinutesLeft() {
+    if (!sys.emberGuardianTimerActive) return -1;
+    unsigned long elapsed = millis() - sys.emberGuardianStartMs;
+    unsigned long total   = (unsigned long)sys.emberGuardianTimerMinutes * 60000UL;
+    return elapsed < total ? (int32_t)((total - elapsed) / 60000UL) : 0;
+}
+
+// Screens showing values outside SystemData (WiFi RSSI / IP)
+static bool uiScreenIsLive(UIState st) {
+    return st == UI_NETWORK_INFO;
+}
+
+/* ============================================================
+ *  PUBLIC: RATE‑LIMITED UPDATE
+ * ============================================================ */
+bool ui_update(unsigned long now, double exhaustF, int fanPercent)
+{
+    static UIState       lastState    = UI_STATE_COUNT;
+    static int32_t       lastMinutes  = -1;
+    static unsigned long lastRenderMs = 0;
+    static bool          rendered     = false;
+
+    if (bootScreenStep(now)) return false;
+
+    const unsigned long frameMs = 1000UL / UI_MAX_FPS;
+
+    bool due = rendered ? (now - lastRenderMs >= frameMs) : true;
+
+    if (due) {
+        // Taken only when a frame is due: changes accumulate meanwhile
+        SysFieldMask changed = sysf_take(SYSF_UI);
+
+        int32_t minutes = uiGuardianMinutesLeft();
+
+        bool live = uiScreenIsLive(uiState) &&
+                    now - lastRenderMs >= UI_LIVE_REFRESH_MS;
+
+        if (uiNeedRedraw || !rendered || live ||
+            uiState != lastState ||
+            (changed & uiScreenFields(uiState)) ||
+            (uiState == UI_HOME && minutes != lastMinutes))
+        {
+            lastState    = uiState;
+            lastMinutes  = minutes;
+            lastRenderMs = now;
+            rendered     = true;
+            uiNeedRedraw = false;
+
+            ui_showScreen(uiState, exhaustF, fanPercent);
+            return true;
+        }
+    }
+
+    // Finish a frame that ran out of LCD budget
+    if (lcdframe_pending()) lcdframe_flush();
+    return false;
+}
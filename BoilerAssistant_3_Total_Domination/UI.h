@@ -11,9 +11,10 @@
  *    Public interface for the keypad‑driven LCD UI subsystem.
  *    This module exposes deterministic entry points for:
  *
- *      • ui_init()       — initialize LCD + boot screen
+ *      • ui_init()       — initialize LCD, start the boot screen
  *      • ui_handleKey()  — process keypad input and update UI state
  *      • ui_showScreen() — render the active UI state
+ *      • ui_update()     — render only when something shown changed
  *
  *    Architectural Notes:
  *      - All UI state definitions live in SystemState.h
@@ -31,12 +32,23 @@
 #include <Arduino.h>
 #include "SystemState.h"   // UIState enum lives here
 
+// Render rate cap (frames per second)
+#ifndef UI_MAX_FPS
+#define UI_MAX_FPS 4
+#endif
+
+// Refresh period for screens with values outside SystemData
+#ifndef UI_LIVE_REFRESH_MS
+#define UI_LIVE_REFRESH_MS 1000UL
+#endif
+
 /* ============================================================
  *  PUBLIC UI FUNCTIONS
  * ============================================================ */
 
 /**
- * Initialize LCD, boot screen, and UI state.
+ * Initialize LCD and UI state. Returns at once; the boot screen is
+ * drawn by the following ui_update() calls.
  */
 void ui_init();
 
@@ -58,4 +70,15 @@ void ui_handleKey(char key, double exhaustF, int fanPercent);
  */
 void ui_showScreen(UIState st, double exhaustF, int fanPercent);
 
+/**
+ * Render the active screen if a key was handled (sys.uiNeedsRefresh),
+ * a field the screen shows changed (SystemFields SYSF_UI mask), or a
+ * live screen is due — after the boot screen has finished,
+ * at most UI_MAX_FPS times per second. Otherwise only finishes an
+ * LCD frame that ran out of budget.
+ *
+ * @return true if the screen was re‑rendered
+ */
+bool ui_update(unsigned long now, double exhaustF, int fanPercent);
+
 #endif // UI_H
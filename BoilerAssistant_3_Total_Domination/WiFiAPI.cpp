@@ -18,12 +18,28 @@
  *      • JSON endpoints:
  *          - GET  /api/state
  *          - GET  /api/settings
+ *          - GET  /api/perf
  *          - POST /api/set
  *      • Remote write‑back to SystemData with remoteChanged flag
  *
+ *    HTTP handling:
+ *      Up to WIFIAPI_MAX_CONN connections, each with its own parser
+ *      state machine and fixed buffers:
+ *
+ *        LINE    request line → method + path (query dropped)
+ *        HEAD    headers, one line at a time; Content-Length kept
+ *        BODY    exactly Content-Length bytes (≤ WIFIAPI_BODY_MAX)
+ *        REPLY   route, write the response, close
+ *
+ *      wifiapi_loop() services the connections round‑robin and
+ *      stops once WIFIAPI_BUDGET_US is spent; the rest continue on
+ *      the next pass. Connections idle for WIFIAPI_IDLE_MS close.
+ *      Nothing waits on a socket, so a slow phone can never stall
+ *      the control task.
+ *
  *    Architectural Notes:
- *      - No blocking delays
- *      - No dynamic allocation beyond ArduinoJson buffers
+ *      - No blocking delays (no Stream timeouts, no readString)
+ *      - No dynamic allocation; responses serialize into txBuf
  *      - Provisioning-aware: disabled in AP mode
  *      - SystemData is the single source of truth
  *
@@ -36,6 +52,8 @@
 #include "SystemData.h"
 #include "RuntimeCredentials.h"
 #include "WiFiProvisioning.h"
+#include "LoopPerf.h"
+#include "Telemetry.h"
 
 #include <WiFiS3.h>
 #include <WiFiServer.h>
@@ -76,56 +94,119 @@ static unsigned long lastWifiAttempt = 0;
  *  JSON Documents
  * ============================================================ */
 
-static StaticJsonDocument<512> stateDoc;
+static StaticJsonDocument<768> stateDoc;      // water[8] + thermocouples[4]
 static StaticJsonDocument<512> settingsDoc;
 
+/* ============================================================
+ *  Connections
+ * ============================================================ */
+
+enum HttpState : uint8_t {
+    HTTP_FREE,
+    HTTP_LINE,
+    HTTP_HEAD,
+    HTTP_BODY,
+    HTTP_REPLY
+};
+
+enum HttpMethod : uint8_t {
+    METHOD_OTHER,
+    METHOD_GET,
+    METHOD_POST
+};
+
+struct HttpConn {
+    WiFiClient    client;
+    HttpState     state;
+    HttpMethod    method;
+    unsigned long lastMs;               // last byte received
+    uint16_t      status;               // != 0: reply with this error
+
+    char          line[WIFIAPI_LINE_MAX];
+    uint16_t      lineLen;
+
+    char          path[WIFIAPI_PATH_MAX];
+
+    char          body[WIFIAPI_BODY_MAX + 1];
+    uint16_t      bodyLen;
+    uint16_t      bodyWant;
+};
+
+static HttpConn conns[WIFIAPI_MAX_CONN];
+static uint8_t  nextConn = 0;           // round‑robin start
+
+// Shared response buffer for state/settings (replies are written in
+// one step); /api/perf streams and does not use it
+static char txBuf[1024];
+
 /* ============================================================
  *  Helpers
  * ============================================================ */
 
-static void sendJson(WiFiClient& client, const String& json) {
-    client.println("HTTP/1.1 200 OK");
+static void sendHeader(WiFiClient& client, const char* status, size_t len) {
+    client.print("HTTP/1.1 ");
+    client.println(status);
     client.println("Content-Type: application/json");
+    client.print("Content-Length: ");
+    client.println((unsigned long)len);
     client.println("Connection: close");
     client.println();
-    client.print(json);
 }
 
-static void sendNotFound(WiFiClient& client) {
-    client.println("HTTP/1.1 404 Not Found");
-    client.println("Connection: close");
-    client.println();
+static void sendJson(WiFiClient& client, const char* json) {
+    size_t len = strlen(json);
+    sendHeader(client, "200 OK", len);
+    client.write((const uint8_t*)json, len);
+}
+
+static void sendError(WiFiClient& client, uint16_t status) {
+    const char* text = "400 Bad Request";
+    if (status == 404) text = "404 Not Found";
+    if (status == 405) text = "405 Method Not Allowed";
+    if (status == 413) text = "413 Payload Too Large";
+
+    sendHeader(client, text, 0);
 }
 
 /* ============================================================
- *  JSON Builders
+ *  JSON Builders (into txBuf)
  * ============================================================ */
 
-static String buildStateJson() {
+static const char* buildStateJson() {
+    TelemetrySnapshot t;
+
     stateDoc.clear();
 
-    stateDoc["exhaust_smooth"] = sys.exhaustSmoothF;
-    stateDoc["fan"]            = sys.fanFinal;
-    stateDoc["burn_state"]     = sys.burnState;
+    stateDoc["seq"]            = telemetry_read(&t);
+    stateDoc["exhaust_smooth"] = t.exhaustF;
+    stateDoc["fan"]            = t.fanPercent;
+    stateDoc["burn_state"]     = t.burnState;
 
     stateDoc["rssi"]           = WiFi.RSSI();
 
     JsonObject env = stateDoc.createNestedObject("env");
-    env["temp_f"]   = sys.envTempF;
-    env["humidity"] = sys.envHumidity;
-    env["pressure"] = sys.envPressure;
+    env["temp_f"]   = t.envTempF;
+    env["humidity"] = t.envHumidity;
+    env["pressure"] = t.envPressure;
 
     JsonArray water = stateDoc.createNestedArray("water");
-    for (uint8_t i = 0; i < sys.waterProbeCount; i++) {
-        water.add(sys.waterTempF[i]);
+    for (uint8_t i = 0; i < t.waterProbeCount; i++) {
+        water.add(t.waterTempF[i]);
     }
 
-    String out;
-    serializeJson(stateDoc, out);
-    return out;
+    JsonArray tc = stateDoc.createNestedArray("thermocouples");
+    for (uint8_t i = 0; i < TC_CHANNELS; i++) {
+        JsonObject ch = tc.createNestedObject();
+        ch["temp_f"] = t.tcTempF[i];
+        ch["cj_f"]   = t.tcColdJunctionF[i];
+        ch["fault"]  = t.tcFault[i];
+    }
+
+    serializeJson(stateDoc, txBuf, sizeof(txBuf));
+    return txBuf;
 }
 
-static String buildSettingsJson() {
+static const char* buildSettingsJson() {
     settingsDoc.clear();
 
     settingsDoc["exhaust_setpoint"] = sys.exhaustSetpoint;
@@ -138,18 +219,24 @@ static String buildSettingsJson() {
     settingsDoc["flue_low"]         = sys.flueLowThreshold;
     settingsDoc["flue_recovery"]    = sys.flueRecoveryThreshold;
 
-    String out;
-    serializeJson(settingsDoc, out);
-    return out;
+    serializeJson(settingsDoc, txBuf, sizeof(txBuf));
+    return txBuf;
+}
+
+static void sendPerf(WiFiClient& client) {
+    uint32_t up = millis();
+
+    sendHeader(client, "200 OK", perf_jsonLength(up));
+    perf_writeJson(client, up);
 }
 
 /* ============================================================
  *  POST /api/set
  * ============================================================ */
 
-static void handleApiSet(WiFiClient& client, const String& body) {
+static void handleApiSet(WiFiClient& client, const char* body, uint16_t len) {
     StaticJsonDocument<256> doc;
-    DeserializationError err = deserializeJson(doc, body);
+    DeserializationError err = deserializeJson(doc, body, len);
 
     if (err) {
         sendJson(client, "{\"error\":\"invalid JSON\"}");
@@ -202,6 +289,184 @@ static void handleApiSet(WiFiClient& client, const String& body) {
     sendJson(client, "{\"ok\":true}");
 }
 
+/* ============================================================
+ *  HTTP Parser (per connection)
+ * ============================================================ */
+
+static void http_close(HttpConn& c) {
+    c.client.stop();
+    c.state = HTTP_FREE;
+}
+
+static void http_closeAll() {
+    for (HttpConn& c : conns) {
+        if (c.state != HTTP_FREE) http_close(c);
+    }
+}
+
+static void http_open(HttpConn& c, WiFiClient& client, unsigned long now) {
+    c.client   = client;
+    c.state    = HTTP_LINE;
+    c.method   = METHOD_OTHER;
+    c.lastMs   = now;
+    c.status   = 0;
+    c.lineLen  = 0;
+    c.path[0]  = '\0';
+    c.bodyLen  = 0;
+    c.bodyWant = 0;
+}
+
+// "GET /api/state?x=1 HTTP/1.1" → method + "/api/state"
+static void http_requestLine(HttpConn& c) {
+    char* sp = strchr(c.line, ' ');
+    if (!sp) { c.status = 400; return; }
+
+    *sp = '\0';
+    if      (strcmp(c.line, "GET")  == 0) c.method = METHOD_GET;
+    else if (strcmp(c.line, "POST") == 0) c.method = METHOD_POST;
+
+    const char* target = sp + 1;
+    uint8_t n = 0;
+    while (target[n] && target[n] != ' ' && target[n] != '?' && n < WIFIAPI_PATH_MAX - 1) {
+        c.path[n] = target[n];
+        n++;
+    }
+    c.path[n] = '\0';
+}
+
+// One complete line (CR/LF stripped) in c.line
+static void http_line(HttpConn& c) {
+    if (c.state == HTTP_LINE) {
+        if (c.lineLen == 0) return;             // tolerate leading CRLF
+        http_requestLine(c);
+        c.state = HTTP_HEAD;
+        return;
+    }
+
+    if (c.lineLen == 0) {                       // end of headers
+        if (c.bodyWant > WIFIAPI_BODY_MAX) {
+            c.status = 413;
+            c.state  = HTTP_REPLY;
+        } else {
+            c.state = (c.bodyWant > 0) ? HTTP_BODY : HTTP_REPLY;
+        }
+        return;
+    }
+
+    if (strncasecmp(c.line, "Content-Length:", 15) == 0) {
+        long n = atol(c.line + 15);
+        c.bodyWant = (uint16_t)constrain(n, 0L, (long)WIFIAPI_BODY_MAX + 1);
+    }
+}
+
+// Feed received bytes through the parser
+static void http_feed(HttpConn& c, const uint8_t* data, int n) {
+    for (int i = 0; i < n && c.state != HTTP_REPLY; i++) {
+        char ch = (char)data[i];
+
+        if (c.state == HTTP_BODY) {
+            c.body[c.bodyLen++] = ch;
+            if (c.bodyLen >= c.bodyWant) c.state = HTTP_REPLY;
+            continue;
+        }
+
+        if (ch == '\r') continue;
+        if (ch == '\n') {
+            c.line[c.lineLen] = '\0';
+            http_line(c);
+            c.lineLen = 0;
+            continue;
+        }
+        if (c.lineLen < WIFIAPI_LINE_MAX - 1) c.line[c.lineLen++] = ch;   // long headers truncate
+    }
+}
+
+static void http_route(HttpConn& c) {
+    if (c.status) {
+        sendError(c.client, c.status);
+        return;
+    }
+
+    if (strcmp(c.path, "/api/set") == 0) {
+        if (c.method != METHOD_POST) { sendError(c.client, 405); return; }
+        c.body[c.bodyLen] = '\0';
+        handleApiSet(c.client, c.body, c.bodyLen);
+        return;
+    }
+
+    if (c.method != METHOD_GET) {
+        sendError(c.client, strncmp(c.path, "/api/", 5) == 0 ? 405 : 404);
+        return;
+    }
+
+    if      (strcmp(c.path, "/api/state")    == 0) sendJson(c.client, buildStateJson());
+    else if (strcmp(c.path, "/api/settings") == 0) sendJson(c.client, buildSettingsJson());
+    else if (strcmp(c.path, "/api/perf")     == 0) sendPerf(c.client);
+    else                                           sendError(c.client, 404);
+}
+
+// One bounded step of one connection
+static void http_step(HttpConn& c, unsigned long now) {
+    if (c.state != HTTP_REPLY) {
+        int avail = c.client.available();
+
+        if (avail > 0) {
+            uint8_t chunk[WIFIAPI_RX_CHUNK];
+            if (avail > (int)sizeof(chunk)) avail = sizeof(chunk);
+            int n = c.client.read(chunk, (size_t)avail);
+            if (n > 0) {
+                http_feed(c, chunk, n);
+                c.lastMs = now;
+            }
+        }
+        else if (!c.client.connected() || now - c.lastMs > WIFIAPI_IDLE_MS) {
+            http_close(c);
+            return;
+        }
+    }
+
+    if (c.state == HTTP_REPLY) {
+        http_route(c);
+        http_close(c);
+    }
+}
+
+static void http_poll(unsigned long startUs) {
+    unsigned long now = millis();
+
+    // Accept every pending connection into a free slot
+    for (;;) {
+        HttpConn* slot = nullptr;
+        for (HttpConn& c : conns) {
+            if (c.state == HTTP_FREE) { slot = &c; break; }
+        }
+        if (!slot) break;                       // full: stays queued in the stack
+
+        WiFiClient client = server.accept();
+        if (!client) break;
+
+        http_open(*slot, client, now);
+    }
+
+    // Round‑robin until every connection is idle or the budget is spent
+    bool progress = true;
+    while (progress && micros() - startUs < WIFIAPI_BUDGET_US) {
+        progress = false;
+
+        for (uint8_t k = 0; k < WIFIAPI_MAX_CONN; k++) {
+            HttpConn& c = conns[(nextConn + k) % WIFIAPI_MAX_CONN];
+            if (c.state == HTTP_FREE) continue;
+
+            http_step(c, now);
+            if (c.state == HTTP_FREE || c.client.available() > 0) progress = true;
+
+            if (micros() - startUs >= WIFIAPI_BUDGET_US) break;
+        }
+
+        nextConn = (nextConn + 1) % WIFIAPI_MAX_CONN;
+    }
+}
+
 /* ============================================================
  *  WiFi Init (provisioning-aware)
  * ============================================================ */
@@ -223,10 +488,13 @@ void wifiapi_init() {
         return;
     }
 
-    Serial.print("WiFiAPI: connecting to SSID: ");
-    Serial.println(ssid);
+    // Provisioning normally associated already; only re-join if not
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.print("WiFiAPI: connecting to SSID: ");
+        Serial.println(ssid);
 
-    WiFi.begin(ssid, pass);
+        WiFi.begin(ssid, pass);
+    }
     lastWifiAttempt = millis();
 
     server.begin();
@@ -245,6 +513,7 @@ void wifiapi_loop() {
 
     if (WiFi.status() != WL_CONNECTED) {
         sys.wifiOK = false;
+        http_closeAll();
 
         unsigned long now = millis();
 
@@ -280,36 +549,5 @@ void wifiapi_loop() {
         Serial.println(ip);
     }
 
-    WiFiClient client = server.available();
-    if (!client) return;
-
-    if (!client.available()) {
-        client.stop();
-        return;
-    }
-
-    String req = client.readStringUntil('\r');
-    client.readStringUntil('\n');
-
-    String body = "";
-    if (req.startsWith("POST")) {
-        while (client.available()) {
-            body += client.readString();
-        }
-    }
-
-    if (req.startsWith("GET /api/state")) {
-        sendJson(client, buildStateJson());
-    }
-    else if (req.startsWith("GET /api/settings")) {
-        sendJson(client, buildSettingsJson());
-    }
-    else if (req.startsWith("POST /api/set")) {
-        handleApiSet(client, body);
-    }
-    else {
-        sendNotFound(client);
-    }
-
-    client.stop();
+    http_poll(micros());
 }
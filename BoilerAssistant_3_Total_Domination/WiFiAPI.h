@@ -20,11 +20,14 @@
  *          • Live telemetry
  *          • Settings
  *          • Network diagnostics
+ *          • Loop timing statistics
  *      - Integrate cleanly with MQTT and LoRa without blocking
  *
  *    Architectural Notes:
  *      - All implementation resides in WiFiAPI.cpp
  *      - Provisioning-aware: disabled in AP mode
+ *      - Per‑connection HTTP parser with fixed buffers; HTTP work
+ *        per call is bounded by WIFIAPI_BUDGET_US
  *      - SystemData is the single source of truth
  *
  *  Version:
@@ -34,6 +37,17 @@
 
 #pragma once
 
+/* ============================================================
+ *  HTTP server limits
+ * ============================================================ */
+#define WIFIAPI_MAX_CONN     3         // concurrent connections
+#define WIFIAPI_LINE_MAX     128       // request line / header line
+#define WIFIAPI_PATH_MAX     32        // request path (query dropped)
+#define WIFIAPI_BODY_MAX     256       // POST body (/api/set)
+#define WIFIAPI_RX_CHUNK     64        // bytes read per connection step
+#define WIFIAPI_BUDGET_US    3000UL    // HTTP work per wifiapi_loop()
+#define WIFIAPI_IDLE_MS      2000UL    // close silent connections
+
 // Initialize WiFi + HTTP JSON API (non‑blocking)
 void wifiapi_init();
 
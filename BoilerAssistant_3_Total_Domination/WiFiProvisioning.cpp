@@ -58,6 +58,24 @@ static WiFiServer provServer(80);
 static bool apMode   = false;
 static bool newCreds = false;
 
+/* Boot‑time association, stepped from wifi_prov_loop() */
+enum ProvState : uint8_t {
+    PROV_IDLE,          // wifi_prov_init() not called yet
+    PROV_STA_SETTLE,    // radio reset, waiting PROV_SETTLE_MS
+    PROV_STA_JOIN,      // WiFi.begin() issued, polling status
+    PROV_STA_UP,        // associated; WiFiAPI / MQTT take over
+    PROV_AP_SETTLE,     // radio reset before beginAP()
+    PROV_AP_UP          // portal serving
+};
+
+static ProvState     provState   = PROV_IDLE;
+static unsigned long provStateMs = 0;
+
+static void prov_enter(ProvState st) {
+    provState   = st;
+    provStateMs = millis();
+}
+
 /* Simple HTML portal */
 static const char* PROV_HTML =
 "<!DOCTYPE html><html><body>"
@@ -72,6 +90,30 @@ static const char* PROV_HTML =
 "<input type='submit' value='Save'>"
 "</form></body></html>";
 
+/* ============================================================
+ *  DEFERRED REBOOT
+ *  ------------------------------------------------------------
+ *  Reboots are scheduled, not slept through: wifi_prov_loop()
+ *  commits EEPROM and resets once the deadline passes, so the
+ *  control task keeps running while the reply goes out.
+ * ============================================================ */
+
+static bool          rebootPending = false;
+static unsigned long rebootAtMs    = 0;
+
+static void prov_scheduleReboot(unsigned long delayMs) {
+    rebootPending = true;
+    rebootAtMs    = millis() + delayMs;
+}
+
+static void prov_rebootStep(unsigned long now) {
+    if (!rebootPending || (long)(now - rebootAtMs) < 0) return;
+
+    Serial.println("WiFiProvisioning: RESETTING NOW");
+    eeprom_commit();
+    NVIC_SystemReset();
+}
+
 /* ============================================================
  *  FACTORY RESET
  * ============================================================ */
@@ -84,12 +126,11 @@ void wifi_prov_factoryReset() {
 
     sys.wifiOK = false;
 
-    // Persist the cleared credentials
+    // Persist the cleared credentials (committed before the reset)
     eeprom_saveRuntimeCreds();
 
     Serial.println("WiFiProvisioning: rebooting after factory reset...");
-    delay(1000);
-    NVIC_SystemReset();
+    prov_scheduleReboot(PROV_REBOOT_DELAY_MS);
 }
 
 /* ============================================================
@@ -101,8 +142,12 @@ static void startAP() {
 
     WiFi.end();
     WiFi.disconnect();
-    delay(200);
 
+    sys.wifiOK = false;
+    prov_enter(PROV_AP_SETTLE);
+}
+
+static void startAPSettled() {
     WiFi.config(
         IPAddress(192,168,4,1),
         IPAddress(0,0,0,0),
@@ -118,6 +163,7 @@ static void startAP() {
     sys.wifiOK = false;
 
     provServer.begin();
+    prov_enter(PROV_AP_UP);
 }
 
 /* ============================================================
@@ -129,42 +175,66 @@ void wifi_prov_init() {
 
     sys.wifiOK = false;
 
+    // WiFi.begin() must return at once; association is polled below
+    WiFi.setTimeout(PROV_BEGIN_BLOCK_MS);
+
     if (runtimeCreds.hasCredentials && runtimeCreds.ssid[0] != 0) {
         Serial.print("WiFiProvisioning: Using runtime SSID: ");
         Serial.println(runtimeCreds.ssid);
 
         WiFi.end();
         WiFi.disconnect();
-        delay(200);
+        prov_enter(PROV_STA_SETTLE);
+        return;
+    }
 
+    Serial.println("WiFiProvisioning: No runtime credentials → AP mode");
+    startAP();
+}
+
+/* ============================================================
+ *  BOOT ASSOCIATION STEP
+ * ============================================================ */
+
+static void prov_step(unsigned long now) {
+    switch (provState) {
+
+    case PROV_STA_SETTLE:
+        if (now - provStateMs < PROV_SETTLE_MS) return;
         WiFi.begin(runtimeCreds.ssid, runtimeCreds.pass);
+        prov_enter(PROV_STA_JOIN);
+        return;
 
-        unsigned long start = millis();
-        while (millis() - start < 8000) {
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.println("WiFiProvisioning: STA connected via runtime creds");
-                Serial.print("WiFiProvisioning: IP: ");
-                Serial.println(WiFi.localIP());
+    case PROV_STA_JOIN:
+        if (WiFi.status() == WL_CONNECTED) {
+            Serial.println("WiFiProvisioning: STA connected via runtime creds");
+            Serial.print("WiFiProvisioning: IP: ");
+            Serial.println(WiFi.localIP());
 
-                apMode     = false;
-                sys.wifiOK = true;
+            apMode     = false;
+            sys.wifiOK = true;
 
-                prov_mqtt_server = runtimeCreds.mqttServer;
-                prov_mqtt_user   = runtimeCreds.mqttUser;
-                prov_mqtt_pass   = runtimeCreds.mqttPass;
+            prov_mqtt_server = runtimeCreds.mqttServer;
+            prov_mqtt_user   = runtimeCreds.mqttUser;
+            prov_mqtt_pass   = runtimeCreds.mqttPass;
 
-                return;
-            }
-            delay(200);
+            prov_enter(PROV_STA_UP);
+            return;
+        }
+        if (now - provStateMs >= PROV_STA_TIMEOUT_MS) {
+            Serial.println("WiFiProvisioning: Runtime STA failed → AP mode");
+            startAP();
         }
+        return;
 
-        Serial.println("WiFiProvisioning: Runtime STA failed → AP mode");
-        startAP();
+    case PROV_AP_SETTLE:
+        if (now - provStateMs < PROV_SETTLE_MS) return;
+        startAPSettled();
         return;
-    }
 
-    Serial.println("WiFiProvisioning: No runtime credentials → AP mode");
-    startAP();
+    default:
+        return;
+    }
 }
 
 /* ============================================================
@@ -179,113 +249,234 @@ bool wifi_prov_isAPMode() {
     return apMode;
 }
 
+bool wifi_prov_staReady() {
+    return provState == PROV_STA_UP;
+}
+
 /* ============================================================
  *  FORM PARSER
+ *  ------------------------------------------------------------
+ *  application/x-www-form-urlencoded, decoded in place from the
+ *  fixed body buffer straight into RuntimeCredentials.
  * ============================================================ */
 
-static void parseForm(const String& body) {
-    auto getVal = [&](const String& key) {
-        int p = body.indexOf(key + "=");
-        if (p < 0) return String("");
-        int s = p + key.length() + 1;
-        int e = body.indexOf('&', s);
-        if (e < 0) e = body.length();
-        String v = body.substring(s, e);
-        v.replace('+', ' ');
-        return v;
-    };
-
-    String ssid       = getVal("ssid");
-    String pass       = getVal("pass");
-    String mqttServer = getVal("mqttServer");
-    String mqttUser   = getVal("mqttUser");
-    String mqttPass   = getVal("mqttPass");
-    String otaPass    = getVal("otaPass");
-
-    if (ssid.length() == 0 || pass.length() == 0) {
-        Serial.println("WiFiProvisioning: missing SSID or password");
-        return;
-    }
+static int hexNibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
 
-    // Safe copies with guaranteed null-termination
-    strncpy(runtimeCreds.ssid, ssid.c_str(), sizeof(runtimeCreds.ssid) - 1);
-    runtimeCreds.ssid[sizeof(runtimeCreds.ssid) - 1] = '\0';
+// Copy the decoded value of key into out (truncated, terminated)
+static bool formValue(const char* body, const char* key, char* out, size_t outSize) {
+    size_t keyLen = strlen(key);
+    const char* p = body;
+
+    while (*p) {
+        const char* end = strchr(p, '&');
+        if (!end) end = p + strlen(p);
+
+        if ((size_t)(end - p) > keyLen && strncmp(p, key, keyLen) == 0 && p[keyLen] == '=') {
+            size_t n = 0;
+            for (const char* v = p + keyLen + 1; v < end && n < outSize - 1; v++) {
+                char c = *v;
+                if (c == '+') {
+                    c = ' ';
+                } else if (c == '%' && end - v > 2) {
+                    int hi = hexNibble(v[1]);
+                    int lo = hexNibble(v[2]);
+                    if (hi >= 0 && lo >= 0) {
+                        c  = (char)((hi << 4) | lo);
+                        v += 2;
+                    }
+                }
+                out[n++] = c;
+            }
+            out[n] = '\0';
+            return true;
+        }
 
-    strncpy(runtimeCreds.pass, pass.c_str(), sizeof(runtimeCreds.pass) - 1);
-    runtimeCreds.pass[sizeof(runtimeCreds.pass) - 1] = '\0';
+        p = (*end) ? end + 1 : end;
+    }
 
-    strncpy(runtimeCreds.mqttServer, mqttServer.c_str(), sizeof(runtimeCreds.mqttServer) - 1);
-    runtimeCreds.mqttServer[sizeof(runtimeCreds.mqttServer) - 1] = '\0';
+    out[0] = '\0';
+    return false;
+}
 
-    strncpy(runtimeCreds.mqttUser, mqttUser.c_str(), sizeof(runtimeCreds.mqttUser) - 1);
-    runtimeCreds.mqttUser[sizeof(runtimeCreds.mqttUser) - 1] = '\0';
+static bool parseForm(const char* body) {
+    RuntimeCredentials rc;
 
-    strncpy(runtimeCreds.mqttPass, mqttPass.c_str(), sizeof(runtimeCreds.mqttPass) - 1);
-    runtimeCreds.mqttPass[sizeof(runtimeCreds.mqttPass) - 1] = '\0';
+    formValue(body, "ssid",       rc.ssid,       sizeof(rc.ssid));
+    formValue(body, "pass",       rc.pass,       sizeof(rc.pass));
+    formValue(body, "mqttServer", rc.mqttServer, sizeof(rc.mqttServer));
+    formValue(body, "mqttUser",   rc.mqttUser,   sizeof(rc.mqttUser));
+    formValue(body, "mqttPass",   rc.mqttPass,   sizeof(rc.mqttPass));
+    formValue(body, "otaPass",    rc.otaPass,    sizeof(rc.otaPass));
 
-    strncpy(runtimeCreds.otaPass, otaPass.c_str(), sizeof(runtimeCreds.otaPass) - 1);
-    runtimeCreds.otaPass[sizeof(runtimeCreds.otaPass) - 1] = '\0';
+    if (rc.ssid[0] == 0 || rc.pass[0] == 0) {
+        Serial.println("WiFiProvisioning: missing SSID or password");
+        return false;
+    }
 
-    runtimeCreds.hasCredentials = true;
+    rc.hasCredentials = true;
+    runtimeCreds = rc;
     newCreds = true;
 
     prov_mqtt_server = runtimeCreds.mqttServer;
     prov_mqtt_user   = runtimeCreds.mqttUser;
     prov_mqtt_pass   = runtimeCreds.mqttPass;
 
-    // Persist credentials
+    // Persist credentials (committed before the reset)
     eeprom_saveRuntimeCreds();
 
     Serial.println("WiFiProvisioning: New credentials received and saved to EEPROM");
+    return true;
 }
 
 /* ============================================================
- *  LOOP: AP Portal
+ *  AP PORTAL — INCREMENTAL HTTP HANDLER
+ *  ------------------------------------------------------------
+ *  One client at a time. Each wifi_prov_loop() pass reads at
+ *  most PROV_RX_PER_PASS bytes:
+ *
+ *    IDLE     accept a client
+ *    HEAD     request line + headers, one line at a time into
+ *             rxLine[] (method, Content-Length kept)
+ *    BODY     Content-Length bytes into rxBody[]
+ *    REPLY    form page, or save + schedule the reboot
+ *
+ *  A client that stalls for PROV_CLIENT_TIMEOUT_MS is dropped.
  * ============================================================ */
 
-void wifi_prov_loop() {
-    if (!apMode) return;
+enum PortalState : uint8_t {
+    PORTAL_IDLE,
+    PORTAL_HEAD,
+    PORTAL_BODY,
+    PORTAL_REPLY
+};
+
+static WiFiClient    portalClient;
+static PortalState   portalState   = PORTAL_IDLE;
+static unsigned long portalStartMs = 0;
+
+static char     rxLine[PROV_LINE_MAX];
+static uint16_t rxLineLen   = 0;
+static bool     rxFirstLine = true;
+static bool     rxIsPost    = false;
+
+static char     rxBody[PROV_BODY_MAX + 1];
+static uint16_t rxBodyLen   = 0;
+static uint16_t rxBodyWant  = 0;
+
+static void portal_close() {
+    portalClient.stop();
+    portalState = PORTAL_IDLE;
+}
+
+static void portal_reply(const char* html) {
+    portalClient.println("HTTP/1.1 200 OK");
+    portalClient.println("Content-Type: text/html");
+    portalClient.println("Connection: close");
+    portalClient.println();
+    portalClient.print(html);
+}
 
-    WiFiClient client = provServer.available();
-    if (!client) return;
+// One complete header line (CR/LF stripped) in rxLine
+static void portal_headerLine() {
+    if (rxFirstLine) {
+        rxFirstLine = false;
+        rxIsPost    = (strncmp(rxLine, "POST ", 5) == 0);
 
-    String req;
-    unsigned long start = millis();
+        Serial.print("WiFiProvisioning: ");
+        Serial.println(rxLine);
+        return;
+    }
+
+    if (rxLineLen == 0) {                       // end of headers
+        portalState = (rxIsPost && rxBodyWant) ? PORTAL_BODY : PORTAL_REPLY;
+        return;
+    }
 
-    while (client.connected() && (millis() - start < 2000)) {
-        while (client.available()) {
-            req += (char)client.read();
+    if (strncasecmp(rxLine, "Content-Length:", 15) == 0) {
+        long n = atol(rxLine + 15);
+        rxBodyWant = (uint16_t)constrain(n, 0L, (long)PROV_BODY_MAX);
+    }
+}
+
+static void portal_step(unsigned long now) {
+    if (portalState == PORTAL_IDLE) {
+        portalClient = provServer.available();
+        if (!portalClient) return;
+
+        portalState   = PORTAL_HEAD;
+        portalStartMs = now;
+        rxLineLen     = 0;
+        rxFirstLine   = true;
+        rxIsPost      = false;
+        rxBodyLen     = 0;
+        rxBodyWant    = 0;
+    }
+
+    if (now - portalStartMs > PROV_CLIENT_TIMEOUT_MS || !portalClient.connected()) {
+        if (portalState != PORTAL_REPLY) {
+            Serial.println("WiFiProvisioning: client dropped");
+            portal_close();
+            return;
         }
     }
 
-    if (req.length() == 0) return;
+    uint16_t budget = PROV_RX_PER_PASS;
 
-    Serial.println("WiFiProvisioning: RAW REQUEST BEGIN");
-    Serial.println(req);
-    Serial.println("WiFiProvisioning: RAW REQUEST END");
+    while (budget && portalState == PORTAL_HEAD && portalClient.available()) {
+        char c = (char)portalClient.read();
+        budget--;
 
-    if (req.startsWith("POST ")) {
-        int bodyPos = req.indexOf("\r\n\r\n");
-        if (bodyPos > 0) {
-            String body = req.substring(bodyPos + 4);
-            parseForm(body);
+        if (c == '\r') continue;
+        if (c == '\n') {
+            rxLine[rxLineLen] = '\0';
+            portal_headerLine();
+            rxLineLen = 0;
+            continue;
         }
+        if (rxLineLen < PROV_LINE_MAX - 1) rxLine[rxLineLen++] = c;   // long headers truncate
+    }
 
-        client.println("HTTP/1.1 200 OK");
-        client.println("Content-Type: text/html");
-        client.println();
-        client.println("<html><body><h3>Saved. Rebooting...</h3></body></html>");
-        client.stop();
+    while (budget && portalState == PORTAL_BODY && portalClient.available()) {
+        rxBody[rxBodyLen++] = (char)portalClient.read();
+        budget--;
+        if (rxBodyLen >= rxBodyWant) portalState = PORTAL_REPLY;
+    }
 
-        Serial.println("WiFiProvisioning: RESETTING NOW");
-        delay(500);
-        NVIC_SystemReset();
-        return;
+    if (portalState != PORTAL_REPLY) return;
+
+    if (rxIsPost) {
+        rxBody[rxBodyLen] = '\0';
+
+        if (parseForm(rxBody)) {
+            portal_reply("<html><body><h3>Saved. Rebooting...</h3></body></html>");
+            prov_scheduleReboot(PROV_REBOOT_DELAY_MS);
+        } else {
+            portal_reply("<html><body><h3>SSID and password are required.</h3>"
+                         "<a href='/'>Back</a></body></html>");
+        }
+    } else {
+        portal_reply(PROV_HTML);
     }
 
-    client.println("HTTP/1.1 200 OK");
-    client.println("Content-Type: text/html");
-    client.println();
-    client.print(PROV_HTML);
-    client.stop();
+    portal_close();
+}
+
+/* ============================================================
+ *  LOOP: association step, AP portal, pending reboot
+ * ============================================================ */
+
+void wifi_prov_loop() {
+    unsigned long now = millis();
+
+    prov_rebootStep(now);
+    prov_step(now);
+
+    if (provState != PROV_AP_UP || rebootPending) return;
+
+    portal_step(now);
 }
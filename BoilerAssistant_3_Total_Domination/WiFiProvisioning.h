@@ -12,15 +12,18 @@
  *    This module exposes deterministic entry points for:
  *
  *      • wifi_prov_init()  — STA‑first initialization with AP fallback
- *      • wifi_prov_loop()  — AP‑mode HTML portal handler
+ *      • wifi_prov_loop()  — association step + AP‑mode HTML portal
  *      • wifi_prov_isAPMode() — query active provisioning mode
+ *      • wifi_prov_staReady() — STA associated, networking may start
  *      • wifi_prov_has_credentials() — query stored credentials
- *      • wifi_prov_factoryReset() — full credential wipe + reboot
+ *      • wifi_prov_factoryReset() — full credential wipe + scheduled reboot
  *
  *    Architectural Notes:
  *      - All implementation resides in WiFiProvisioning.cpp
  *      - Provisioning is authoritative when STA fails or no creds exist
  *      - SystemData is the single source of truth for WiFi status
+ *      - wifi_prov_init() only starts association; wifi_prov_loop()
+ *        steps it, so boot never waits on the radio
  *
  *  Version:
  *      Boiler Assistant v3.0 "Total Domination"
@@ -32,9 +35,26 @@
 
 #include <Arduino.h>
 
+/* ============================================================
+ *  Boot association timing
+ * ============================================================ */
+#define PROV_SETTLE_MS         200UL    // radio reset before begin / beginAP
+#define PROV_STA_TIMEOUT_MS    8000UL   // STA join window before AP fallback
+#define PROV_BEGIN_BLOCK_MS    50UL     // cap on WiFi.begin()'s own wait
+
+/* ============================================================
+ *  AP portal (incremental HTTP handler)
+ * ============================================================ */
+#define PROV_LINE_MAX          128      // request line / header line
+#define PROV_BODY_MAX          512      // urlencoded form body
+#define PROV_RX_PER_PASS       256      // bytes read per wifi_prov_loop()
+#define PROV_CLIENT_TIMEOUT_MS 3000UL   // drop a stalled client
+#define PROV_REBOOT_DELAY_MS   500UL    // reply flush before reset
+
 void wifi_prov_init();
 void wifi_prov_loop();
 bool wifi_prov_isAPMode();
+bool wifi_prov_staReady();
 bool wifi_prov_has_credentials();
 
 /* ============================================================
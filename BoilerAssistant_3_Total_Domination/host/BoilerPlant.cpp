@@ -0,0 +1,138 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Outdoor Wood Boiler Plant Model (host)
+ *  ------------------------------------------------------------
+ *  File: host/BoilerPlant.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Explicit‑Euler integration of the model in BoilerPlant.h.
+ *    Stable for steps well below tauFlueS (the sim uses 0.25 s).
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "BoilerPlant.h"
+
+#include <math.h>
+
+static const float PI_F = 3.14159265f;
+
+/* ============================================================
+ *  PARAMETERS
+ * ============================================================ */
+void plant_defaults(PlantParams& p) {
+    p.maxRateLbPerH     = 40.0f;
+    p.halfLoadLb        = 15.0f;
+    p.heatValueBtuPerLb = 7000.0f;
+    p.draftFraction     = 0.30f;
+    p.leakFraction      = 0.06f;
+
+    p.flueRiseF         = 750.0f;
+    p.tauFlueS          = 90.0f;
+
+    p.efficiency        = 0.65f;
+    p.waterCapBtuPerF   = 3400.0f;     // ~400 gal + steel
+    p.houseUA           = 500.0f;
+    p.indoorF           = 68.0f;
+    p.standbyUA         = 100.0f;
+
+    p.outdoorMeanF      = 25.0f;
+    p.outdoorSwingF     = 10.0f;
+}
+
+static float outdoorAt(const PlantParams& p, float timeOfDayH) {
+    // Coldest at 05:00, warmest at 17:00
+    return p.outdoorMeanF -
+           p.outdoorSwingF * cosf(2.0f * PI_F * (timeOfDayH - 5.0f) / 24.0f);
+}
+
+/* ============================================================
+ *  INIT / LOAD
+ * ============================================================ */
+void plant_init(PlantState& s, const PlantParams& p,
+                float fuelLb, float waterF, float timeOfDayH)
+{
+    s.fuelLb   = fuelLb;
+    s.waterF   = waterF;
+    s.outdoorF = outdoorAt(p, timeOfDayH);
+    s.flueF    = s.outdoorF + 0.5f * (waterF - s.outdoorF);
+
+    s.fuelBurnedLb     = 0.0;
+    s.heatReleasedBtu  = 0.0;
+    s.heatDeliveredBtu = 0.0;
+}
+
+void plant_load(PlantState& s, float lb) {
+    if (lb > 0) s.fuelLb += lb;
+}
+
+/* ============================================================
+ *  COMBUSTION
+ * ============================================================ */
+float plant_burnRate(const PlantState& s, const PlantParams& p,
+                     int fanPercent, bool damperOpen)
+{
+    if (s.fuelLb <= 0.0f) return 0.0f;
+
+    float fan = (float)fanPercent / 100.0f;
+    if (fan < 0.0f) fan = 0.0f;
+    if (fan > 1.0f) fan = 1.0f;
+
+    float air = damperOpen
+                ? p.draftFraction + (1.0f - p.draftFraction) * fan
+                : p.leakFraction;
+
+    float loadFactor = s.fuelLb / (s.fuelLb + p.halfLoadLb);
+    return p.maxRateLbPerH * air * loadFactor;
+}
+
+/* ============================================================
+ *  STEP
+ * ============================================================ */
+void plant_step(PlantState& s, const PlantParams& p,
+                float dtS, int fanPercent, bool damperOpen,
+                float timeOfDayH)
+{
+    const float dtH = dtS / 3600.0f;
+
+    s.outdoorF = outdoorAt(p, timeOfDayH);
+
+    // Fuel + heat release
+    float rate   = plant_burnRate(s, p, fanPercent, damperOpen);
+    float burned = rate * dtH;
+    if (burned > s.fuelLb) burned = s.fuelLb;
+    s.fuelLb -= burned;
+
+    float q    = rate * p.heatValueBtuPerLb;                    // BTU/h
+    float qMax = p.maxRateLbPerH * p.heatValueBtuPerLb;
+
+    s.fuelBurnedLb    += burned;
+    s.heatReleasedBtu += (double)burned * p.heatValueBtuPerLb;
+
+    // Flue gas
+    float coldF = s.outdoorF + 0.5f * (s.waterF - s.outdoorF);
+    float fireF = s.waterF + p.flueRiseF * powf(q / qMax, 0.8f);
+    float target = (q > 0.0f) ? (fireF > coldF ? fireF : coldF) : coldF;
+
+    s.flueF += (target - s.flueF) * (dtS / p.tauFlueS);
+
+    // Water side
+    float loadBtuH = 0.0f;
+    if (s.outdoorF < p.indoorF) {
+        loadBtuH = p.houseUA * (p.indoorF - s.outdoorF);
+    }
+    float standbyBtuH = p.standbyUA * (s.waterF - s.outdoorF);
+
+    float netBtuH = p.efficiency * q - loadBtuH - standbyBtuH;
+    s.waterF += netBtuH * dtH / p.waterCapBtuPerF;
+
+    // Open‑system boiler: vents at boiling
+    if (s.waterF > 212.0f) s.waterF = 212.0f;
+
+    s.heatDeliveredBtu += (double)loadBtuH * dtH;
+}
@@ -0,0 +1,106 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Outdoor Wood Boiler Plant Model (host)
+ *  ------------------------------------------------------------
+ *  File: host/BoilerPlant.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Lumped‑parameter thermal model of an outdoor wood boiler,
+ *    used to close the loop around the firmware core on the host.
+ *
+ *      fuel load ──► combustion rate ◄── fan %, damper
+ *                         │
+ *                    heat release
+ *                   ╱            ╲
+ *          flue gas (1st order)   water jacket + tank
+ *                                     │
+ *                    house load (outdoor temp) + standby loss
+ *
+ *    Combustion:
+ *      air   = damper open ? draft + (1 − draft)·fan : leak
+ *      rate  = maxRate · air · M / (M + halfLoad)      [lb/h]
+ *      Q     = rate · heatValue                        [BTU/h]
+ *
+ *    Flue (°F, time constant tauFlue):
+ *      fire  → water + flueRise · (Q / Qmax)^0.8
+ *      cold  → outdoor + ½ (water − outdoor)
+ *
+ *    Water (°F, capacity waterCapBtuPerF):
+ *      C · dT/dt = eff·Q − houseUA·(indoor − outdoor)⁺
+ *                        − standbyUA·(water − outdoor)
+ *
+ *    Outdoor temperature follows a daily sine (coldest at 05:00).
+ *
+ *  Architectural Notes:
+ *      - Pure model: no SystemData, no HAL
+ *      - Parameter defaults describe a ~280 kBTU/h unit with a
+ *        400 gal water jacket; all are overridable
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef BOILER_PLANT_H
+#define BOILER_PLANT_H
+
+struct PlantParams {
+    // Fuel / combustion
+    float maxRateLbPerH;      // burn rate at full air and full load
+    float halfLoadLb;         // fuel mass at which rate halves
+    float heatValueBtuPerLb;  // seasoned hardwood
+    float draftFraction;      // natural draft, damper open, fan off
+    float leakFraction;       // damper closed (smoulder)
+
+    // Flue
+    float flueRiseF;          // flue rise above water at full fire
+    float tauFlueS;
+
+    // Water side
+    float efficiency;         // fraction of heat release into water
+    float waterCapBtuPerF;    // jacket + tank thermal mass
+    float houseUA;            // BTU/h per °F below indoor setpoint
+    float indoorF;
+    float standbyUA;          // jacket loss, BTU/h per °F
+
+    // Outdoor profile
+    float outdoorMeanF;
+    float outdoorSwingF;      // peak‑to‑mean
+};
+
+struct PlantState {
+    float fuelLb;
+    float flueF;
+    float waterF;
+    float outdoorF;
+
+    // Totals
+    double fuelBurnedLb;
+    double heatReleasedBtu;
+    double heatDeliveredBtu;
+};
+
+// Defaults described in the header comment
+void plant_defaults(PlantParams& p);
+
+// Cold start: fuel loaded, flue and water at the given temperatures
+void plant_init(PlantState& s, const PlantParams& p,
+                float fuelLb, float waterF, float timeOfDayH);
+
+// Add fuel (operator reload)
+void plant_load(PlantState& s, float lb);
+
+// Advance dtS seconds with the given actuator state.
+// timeOfDayH drives the outdoor profile.
+void plant_step(PlantState& s, const PlantParams& p,
+                float dtS, int fanPercent, bool damperOpen,
+                float timeOfDayH);
+
+// Current combustion rate (lb/h) for the given actuator state
+float plant_burnRate(const PlantState& s, const PlantParams& p,
+                     int fanPercent, bool damperOpen);
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Sensor Trace Format (host)
+ *  ------------------------------------------------------------
+ *  File: host/Trace.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    CSV / binary readers and writers for Trace.h.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "Trace.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ *  HELPERS
+ * ============================================================ */
+
+// Parse one CSV field; empty or "nan" → NaN. Advances *p past the comma.
+static float parseField(char** p) {
+    char* s = *p;
+    char* end = strchr(s, ',');
+    if (end) *end = '\0';
+
+    while (*s == ' ' || *s == '\t') s++;
+
+    float v = NAN;
+    if (*s && *s != '\r' && *s != '\n' && strncmp(s, "nan", 3) != 0) {
+        char* stop = nullptr;
+        v = strtof(s, &stop);
+        if (stop == s) v = NAN;
+    }
+
+    *p = end ? end + 1 : s + strlen(s);
+    return v;
+}
+
+static void putU32(uint8_t* b, uint32_t v) {
+    b[0] = (uint8_t)v; b[1] = (uint8_t)(v >> 8);
+    b[2] = (uint8_t)(v >> 16); b[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t getU32(const uint8_t* b) {
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) |
+           ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static void putF32(uint8_t* b, float f) {
+    uint32_t v;
+    memcpy(&v, &f, 4);
+    putU32(b, v);
+}
+
+static float getF32(const uint8_t* b) {
+    uint32_t v = getU32(b);
+    float f;
+    memcpy(&f, &v, 4);
+    return f;
+}
+
+/* ============================================================
+ *  LOAD
+ * ============================================================ */
+static bool loadCsv(FILE* f, const char* path, std::vector<TraceSample>& out) {
+    char line[256];
+    unsigned long lineNo = 0;
+    uint32_t lastT = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        lineNo++;
+        if (line[0] == '#' || line[0] == '\r' || line[0] == '\n') continue;
+        if (!strncmp(line, "t_ms", 4)) continue;
+
+        char* p = line;
+        char* stop = nullptr;
+        unsigned long t = strtoul(p, &stop, 10);
+        if (stop == p || *stop != ',') {
+            fprintf(stderr, "%s:%lu: bad timestamp\n", path, lineNo);
+            return false;
+        }
+        p = stop + 1;
+
+        TraceSample s;
+        s.tMs         = (uint32_t)t;
+        s.exhaustRawF = parseField(&p);
+        s.tankF       = parseField(&p);
+        s.outdoorF    = parseField(&p);
+
+        if (!out.empty() && s.tMs < lastT) {
+            fprintf(stderr, "%s:%lu: timestamp goes backwards\n", path, lineNo);
+            return false;
+        }
+        lastT = s.tMs;
+        out.push_back(s);
+    }
+    return true;
+}
+
+static bool loadBin(FILE* f, const char* path, std::vector<TraceSample>& out) {
+    uint8_t hdr[12];
+    if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
+        fprintf(stderr, "%s: short header\n", path);
+        return false;
+    }
+
+    uint16_t version = (uint16_t)(hdr[4] | (hdr[5] << 8));
+    uint32_t count   = getU32(hdr + 8);
+    if (version != TRACE_VERSION) {
+        fprintf(stderr, "%s: unsupported version %u\n", path, version);
+        return false;
+    }
+
+    out.reserve(out.size() + count);
+
+    uint8_t rec[16];
+    for (uint32_t i = 0; i < count; i++) {
+        if (fread(rec, 1, sizeof(rec), f) != sizeof(rec)) {
+            fprintf(stderr, "%s: truncated at record %u\n", path, i);
+            return false;
+        }
+        TraceSample s;
+        s.tMs         = getU32(rec);
+        s.exhaustRawF = getF32(rec + 4);
+        s.tankF       = getF32(rec + 8);
+        s.outdoorF    = getF32(rec + 12);
+        out.push_back(s);
+    }
+    return true;
+}
+
+bool trace_load(const char* path, std::vector<TraceSample>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    char magic[4] = { 0 };
+    size_t n = fread(magic, 1, 4, f);
+    rewind(f);
+
+    bool ok = (n == 4 && !memcmp(magic, TRACE_MAGIC, 4))
+              ? loadBin(f, path, out)
+              : loadCsv(f, path, out);
+    fclose(f);
+    return ok;
+}
+
+/* ============================================================
+ *  SAVE
+ * ============================================================ */
+void trace_writeCsvHeader(FILE* f) {
+    fprintf(f, "t_ms,exhaust_raw_f,tank_f,outdoor_f\n");
+}
+
+void trace_writeCsvSample(FILE* f, const TraceSample& s) {
+    fprintf(f, "%lu,", (unsigned long)s.tMs);
+    if (isnan(s.exhaustRawF)) fputs("nan,", f); else fprintf(f, "%.2f,", s.exhaustRawF);
+    if (isnan(s.tankF))       fputs("nan,", f); else fprintf(f, "%.2f,", s.tankF);
+    if (isnan(s.outdoorF))    fputs("nan\n", f); else fprintf(f, "%.2f\n", s.outdoorF);
+}
+
+bool trace_saveCsv(const char* path, const std::vector<TraceSample>& in) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    trace_writeCsvHeader(f);
+    for (size_t i = 0; i < in.size(); i++) trace_writeCsvSample(f, in[i]);
+    return fclose(f) == 0;
+}
+
+bool trace_saveBin(const char* path, const std::vector<TraceSample>& in) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    uint8_t hdr[12] = { 'B', 'A', 'T', 'R', TRACE_VERSION, 0, 0, 0 };
+    putU32(hdr + 8, (uint32_t)in.size());
+    bool ok = fwrite(hdr, 1, sizeof(hdr), f) == sizeof(hdr);
+
+    uint8_t rec[16];
+    for (size_t i = 0; ok && i < in.size(); i++) {
+        putU32(rec,      in[i].tMs);
+        putF32(rec + 4,  in[i].exhaustRawF);
+        putF32(rec + 8,  in[i].tankF);
+        putF32(rec + 12, in[i].outdoorF);
+        ok = fwrite(rec, 1, sizeof(rec), f) == sizeof(rec);
+    }
+
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
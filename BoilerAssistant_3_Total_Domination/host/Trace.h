@@ -0,0 +1,60 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Sensor Trace Format (host)
+ *  ------------------------------------------------------------
+ *  File: host/Trace.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Timestamped raw sensor samples for replay through the
+ *    firmware core (host/replay_trace).
+ *
+ *    CSV (text, one sample per line):
+ *      t_ms,exhaust_raw_f,tank_f,outdoor_f
+ *      0,152.3,141.0,22.5
+ *      250,nan,141.0,            ← empty / "nan" = missing
+ *
+ *      - Lines starting with '#' and the header line are skipped
+ *      - t_ms must be non‑decreasing (ms since trace start)
+ *
+ *    Binary (little‑endian):
+ *      header  "BATR"  u16 version (1)  u16 reserved  u32 count
+ *      record  u32 t_ms  f32 exhaust  f32 tank  f32 outdoor
+ *      NaN encodes a missing value; 16 bytes per record
+ *
+ *    trace_load() picks the format from the first four bytes.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef HOST_TRACE_H
+#define HOST_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#define TRACE_MAGIC   "BATR"
+#define TRACE_VERSION 1
+
+struct TraceSample {
+    uint32_t tMs;
+    float    exhaustRawF;
+    float    tankF;
+    float    outdoorF;
+};
+
+// Returns false (and prints the reason to stderr) on error
+bool trace_load(const char* path, std::vector<TraceSample>& out);
+bool trace_saveCsv(const char* path, const std::vector<TraceSample>& in);
+bool trace_saveBin(const char* path, const std::vector<TraceSample>& in);
+
+// Streaming CSV writer (plant_sim --trace)
+void trace_writeCsvHeader(FILE* f);
+void trace_writeCsvSample(FILE* f, const TraceSample& s);
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Control Math Equivalence Tool (host)
+ *  ------------------------------------------------------------
+ *  File: host/control_math_equiv.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Proves that the float and Q15.16 control paths produce the
+ *    same fan demand as the v3.0 double code. Every case is run
+ *    through:
+ *
+ *      • reference      — verbatim v3.0 double logic (below)
+ *      • double kernel  — ControlMath.h, CTL_MATH_DOUBLE
+ *      • float kernel   — ControlMath.h, CTL_MATH_FLOAT
+ *      • fixed kernel   — ControlMath.h, CTL_MATH_FIXED
+ *
+ *    Cases:
+ *      • grid sweep of setpoint × deadband × clamps × fan mode,
+ *        exhaust stepped every 0.1 °F across the RAMP/HOLD range
+ *      • pseudo‑random exhaust values with full float mantissa
+ *
+ *    Pass criterion: every kernel bit‑identical to the reference.
+ *
+ *    Mode 0 ratios that are exactly a whole percent (e.g.
+ *    10 × (1 − 4.5/5) = 1) truncate one lower in the reference's
+ *    double rounding; the float and Q15.16 kernels settle those
+ *    ties with the same double expression (see CTL_TIE_EPS).
+ *
+ *    Host ns/call is printed for reference only; the RA4M1 gain is
+ *    measured on target with BA_BENCH_BURNENGINE (see the .ino).
+ *
+ *  Usage:
+ *      control_math_equiv            (exit code 0 = pass)
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "equiv_case.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+/* ============================================================
+ *  REFERENCE (v3.0 BurnEngine.cpp, double)
+ * ============================================================ */
+static long arduino_map(long x, long in_min, long in_max,
+                        long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static int reference_ramp(double exhaustControlF, const EquivCase& c) {
+    if (isnan(exhaustControlF)) return 0;
+
+    double low  = c.setpointF - 200.0;
+    double high = c.setpointF;
+    if (exhaustControlF <= low)  return 100;
+    if (exhaustControlF >= high) return c.clampMinPercent;
+
+    return (int)arduino_map((long)exhaustControlF,
+                            (long)low, (long)high,
+                            100L,
+                            (long)c.clampMinPercent);
+}
+
+static int reference_hold(double exhaustControlF, const EquivCase& c) {
+    if (isnan(exhaustControlF)) return 0;
+
+    double bandHalf = c.deadbandF / 2.0;
+    if (bandHalf <= 0) bandHalf = 1.0;
+
+    double low  = c.setpointF - bandHalf;
+    double high = c.setpointF + bandHalf;
+
+    if (c.fanMode == 1) {
+        if (exhaustControlF <= low)  return c.clampMaxPercent;
+        if (exhaustControlF >= high) return c.clampMinPercent;
+
+        return (int)arduino_map((long)exhaustControlF,
+                                (long)low, (long)high,
+                                (long)c.clampMaxPercent,
+                                (long)c.clampMinPercent);
+    }
+
+    if (c.fanMode == 0) {
+        if (exhaustControlF >= low && exhaustControlF <= high) return 0;
+
+        if (exhaustControlF < low) {
+            double span = bandHalf;
+            double e    = low - exhaustControlF;
+            if (e >= span) return 100;
+            double pct = (double)c.clampMaxPercent * (e / span);
+            if (pct < c.clampMinPercent) pct = c.clampMinPercent;
+            return (int)pct;
+        }
+
+        if (exhaustControlF > high) {
+            double span = bandHalf;
+            double e    = exhaustControlF - high;
+            if (e >= span) return 0;
+            double pct = (double)c.clampMinPercent * (1.0 - (e / span));
+            if (pct < 0) pct = 0;
+            return (int)pct;
+        }
+    }
+
+    return 0;
+}
+
+static int reference_kernel(const EquivCase* c) {
+    double exh = c->exhaustF;
+    int demand = (c->stage == EQUIV_STAGE_RAMP) ? reference_ramp(exh, *c)
+                                                : reference_hold(exh, *c);
+    if (demand > 0) {
+        if (demand < c->clampMinPercent) demand = c->clampMinPercent;
+        if (demand > c->clampMaxPercent) demand = c->clampMaxPercent;
+    } else {
+        demand = 0;
+    }
+    return demand;
+}
+
+/* ============================================================
+ *  CASE GENERATION
+ * ============================================================ */
+static const int SETPOINTS[]  = { 250, 300, 350, 400, 450, 500, 550, 600, 650 };
+static const int DEADBANDS[]  = { 0, 1, 3, 5, 10, 15, 20, 25, 40 };
+static const int CLAMPS[][2]  = { {0, 100}, {10, 100}, {20, 80}, {30, 60}, {25, 90} };
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static uint32_t lcgState = 0x12345678u;
+static uint32_t lcg() {
+    lcgState = lcgState * 1664525u + 1013904223u;
+    return lcgState;
+}
+
+static void buildCases(std::vector<EquivCase>& out) {
+    for (size_t s = 0; s < COUNT_OF(SETPOINTS); s++) {
+        for (size_t k = 0; k < COUNT_OF(CLAMPS); k++) {
+            EquivCase c;
+            c.setpointF       = SETPOINTS[s];
+            c.clampMinPercent = CLAMPS[k][0];
+            c.clampMaxPercent = CLAMPS[k][1];
+
+            // RAMP: setpoint − 250 … setpoint + 20
+            c.stage = EQUIV_STAGE_RAMP;
+            c.deadbandF = 0;
+            c.fanMode = 0;
+            for (int t = -2500; t <= 200; t++) {
+                c.exhaustF = (float)c.setpointF + (float)t * 0.1f;
+                out.push_back(c);
+            }
+
+            // HOLD: setpoint ± 60
+            c.stage = EQUIV_STAGE_HOLD;
+            for (size_t d = 0; d < COUNT_OF(DEADBANDS); d++) {
+                c.deadbandF = DEADBANDS[d];
+                for (uint8_t m = 0; m < 2; m++) {
+                    c.fanMode = m;
+                    for (int t = -600; t <= 600; t++) {
+                        c.exhaustF = (float)c.setpointF + (float)t * 0.1f;
+                        out.push_back(c);
+                    }
+                }
+            }
+        }
+    }
+
+    // Random exhaust values with arbitrary fractional bits
+    for (int i = 0; i < 1000000; i++) {
+        EquivCase c;
+        c.setpointF       = SETPOINTS[lcg() % COUNT_OF(SETPOINTS)];
+        c.deadbandF       = DEADBANDS[lcg() % COUNT_OF(DEADBANDS)];
+        size_t k          = lcg() % COUNT_OF(CLAMPS);
+        c.clampMinPercent = CLAMPS[k][0];
+        c.clampMaxPercent = CLAMPS[k][1];
+        c.fanMode         = (uint8_t)(lcg() & 1u);
+        c.stage           = (uint8_t)(lcg() & 1u);
+
+        float span = (c.stage == EQUIV_STAGE_RAMP) ? 270.0f : 60.0f;
+        float base = (c.stage == EQUIV_STAGE_RAMP) ? -250.0f : -30.0f;
+        float u    = (float)(lcg() >> 8) / 16777216.0f;
+        c.exhaustF = (float)c.setpointF + base + u * span;
+        out.push_back(c);
+    }
+
+    // Sensor fault
+    EquivCase n = out[0];
+    n.exhaustF = NAN;
+    out.push_back(n);
+    n.stage = EQUIV_STAGE_HOLD;
+    out.push_back(n);
+}
+
+/* ============================================================
+ *  COMPARISON + TIMING
+ * ============================================================ */
+typedef int (*KernelFn)(const EquivCase*);
+
+struct KernelResult {
+    size_t mismatches;
+    int    maxDeviation;
+    double nsPerCall;
+};
+
+static volatile int sink;
+
+static double timeKernel(KernelFn fn, const std::vector<EquivCase>& cases) {
+    const int PASSES = 5;
+    int acc = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int p = 0; p < PASSES; p++) {
+        for (size_t i = 0; i < cases.size(); i++) acc += fn(&cases[i]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    sink = acc;
+
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / ((double)cases.size() * PASSES);
+}
+
+static KernelResult runKernel(KernelFn fn,
+                              const std::vector<EquivCase>& cases,
+                              const std::vector<int>& expected,
+                              const char* name)
+{
+    KernelResult r = { 0, 0, 0.0 };
+    size_t shown = 0;
+
+    for (size_t i = 0; i < cases.size(); i++) {
+        int got = fn(&cases[i]);
+        int dev = abs(got - expected[i]);
+        if (dev == 0) continue;
+
+        r.mismatches++;
+        if (dev > r.maxDeviation) r.maxDeviation = dev;
+
+        if (shown < 5) {
+            const EquivCase& c = cases[i];
+            printf("  %-6s %s exh=%.6f sp=%d db=%d clamp=%d..%d mode=%u ref=%d got=%d\n",
+                   name, c.stage == EQUIV_STAGE_RAMP ? "RAMP" : "HOLD",
+                   (double)c.exhaustF, c.setpointF, c.deadbandF,
+                   c.clampMinPercent, c.clampMaxPercent, c.fanMode,
+                   expected[i], got);
+            shown++;
+        }
+    }
+
+    r.nsPerCall = timeKernel(fn, cases);
+    return r;
+}
+
+int main() {
+    std::vector<EquivCase> cases;
+    buildCases(cases);
+
+    std::vector<int> expected(cases.size());
+    for (size_t i = 0; i < cases.size(); i++) {
+        expected[i] = reference_kernel(&cases[i]);
+    }
+
+    struct { const char* name; KernelFn fn; } kernels[] = {
+        { "double", equiv_kernel_double },
+        { "float",  equiv_kernel_float  },
+        { "q16",    equiv_kernel_fixed  },
+    };
+
+    printf("control_math_equiv: %zu cases\n", cases.size());
+
+    double refNs = timeKernel(reference_kernel, cases);
+    bool pass = true;
+
+    printf("%-10s %12s %10s %8s %10s  %s\n",
+           "kernel", "mismatches", "rate %", "max dev", "ns/call", "result");
+    printf("%-10s %12s %10s %8s %10.2f\n", "reference", "-", "-", "-", refNs);
+
+    for (size_t k = 0; k < COUNT_OF(kernels); k++) {
+        KernelResult r = runKernel(kernels[k].fn, cases, expected, kernels[k].name);
+        double rate = 100.0 * (double)r.mismatches / (double)cases.size();
+
+        bool ok = (r.mismatches == 0);
+        if (!ok) pass = false;
+
+        printf("%-10s %12zu %10.4f %8d %10.2f  %s\n",
+               kernels[k].name, r.mismatches, rate, r.maxDeviation,
+               r.nsPerCall, ok ? "PASS" : "FAIL");
+    }
+
+    return pass ? 0 : 1;
+}
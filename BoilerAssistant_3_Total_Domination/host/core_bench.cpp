@@ -0,0 +1,114 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host Core Benchmark
+ *  ------------------------------------------------------------
+ *  File: host/core_bench.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Runs the native firmware core through complete AUTO TANK
+ *    burn cycles (IDLE → BOOST → RAMP → HOLD → IDLE) as fast as
+ *    the host allows. The process is a deliberately crude toy
+ *    (first‑order exhaust, linear tank charge / discharge) — it
+ *    exists to exercise every burn state, not to model a boiler.
+ *
+ *    Useful as a profiling target:
+ *      perf record ./core_bench --cycles 20000
+ *      valgrind --tool=callgrind ./core_bench --cycles 200
+ *
+ *  Usage:
+ *      core_bench [--cycles N] [--continuous]
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "core_step.h"
+#include "HalSim.h"
+#include "SystemState.h"
+#include "Pinout.h"
+
+#include <chrono>
+#include <stdlib.h>
+
+extern SystemData sys;
+
+static const unsigned long TICK_MS = 250;
+
+int main(int argc, char** argv) {
+    unsigned long targetCycles = 1000;
+    RunMode mode = RUNMODE_AUTO_TANK;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cycles") && i + 1 < argc) {
+            targetCycles = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--continuous")) {
+            mode = RUNMODE_CONTINUOUS;
+        } else {
+            fprintf(stderr, "usage: %s [--cycles N] [--continuous]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    core_provision(mode);
+    core_boot();
+
+    float exhaustF = 150.0f;
+    float tankF    = (float)sys.tankLowSetpointF - 5.0f;
+
+    unsigned long long ticks = 0;
+    unsigned long      cycles = 0;
+    unsigned long      stateTicks[8] = { 0 };
+    BurnState          prev = sys.burnState;
+
+    // Continuous mode never returns to IDLE: bound by tick count
+    const unsigned long long maxTicks =
+        (mode == RUNMODE_CONTINUOUS) ? (unsigned long long)targetCycles * 600ULL
+                                     : ~0ULL;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    while (cycles < targetCycles && ticks < maxTicks) {
+        hal_advanceMillis(TICK_MS);
+
+        core_setProcess(tankF, 30.0f);
+        int fan = core_controlTick(exhaustF);
+
+        // Toy process: damper LOW = open
+        bool  open   = hal_pin(PIN_DAMPER)->digital == LOW;
+        float target = open ? 350.0f + 3.0f * (float)fan : 150.0f;
+        exhaustF += (target - exhaustF) * 0.05f;
+        tankF    += (exhaustF > 300.0f) ? 0.02f : -0.01f;
+
+        if (sys.burnState < 8) stateTicks[sys.burnState]++;
+        if (prev == BURN_IDLE && sys.burnState == BURN_BOOST) cycles++;
+        prev = sys.burnState;
+        ticks++;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    double wall = std::chrono::duration<double>(t1 - t0).count();
+    double simS = (double)ticks * TICK_MS / 1000.0;
+
+    printf("core_bench (%s)\n", mode == RUNMODE_AUTO_TANK ? "auto tank" : "continuous");
+    printf("  control ticks   : %llu (%.1f simulated hours)\n", ticks, simS / 3600.0);
+    printf("  burn cycles     : %lu\n", cycles);
+    printf("  wall time       : %.3f s\n", wall);
+    printf("  ticks / s       : %.0f\n", wall > 0 ? (double)ticks / wall : 0.0);
+    printf("  burn cycles / s : %.0f\n", wall > 0 ? (double)cycles / wall : 0.0);
+    printf("  ns / tick       : %.1f\n", ticks ? wall * 1e9 / (double)ticks : 0.0);
+    printf("  realtime factor : %.0fx\n", wall > 0 ? simS / wall : 0.0);
+    printf("  EEPROM writes   : %lu\n", (unsigned long)hal_eepromWrites());
+
+    static const char* const names[] = {
+        "IDLE", "RAMP", "HOLD", "BOOST", "EMBER_GUARD", "5", "6", "7"
+    };
+    for (int s = 0; s < 8; s++) {
+        if (stateTicks[s]) printf("  ticks in %-11s: %lu\n", names[s], stateTicks[s]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host Core Globals
+ *  ------------------------------------------------------------
+ *  File: host/core_globals.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Legacy globals that the core modules reference but that the
+ *    firmware defines in the .ino. Host drivers mirror them from
+ *    sys.* exactly like task_control() does on the board, e.g.
+ *    via core_step() in host/core_step.h.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "SystemState.h"
+
+// FanControl.cpp: extern BurnState burnState;
+BurnState burnState = BURN_IDLE;
@@ -0,0 +1,123 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host Core Step
+ *  ------------------------------------------------------------
+ *  File: host/core_step.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Host mirror of setup() and task_control() for the core
+ *    modules. Keep in step with BoilerAssistant_3_Total_Domination.ino.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "core_step.h"
+#include "HalSim.h"
+
+#include "SystemState.h"
+#include "EEPROMStorage.h"
+#include "EnvironmentalLogic.h"
+#include "BurnEngine.h"
+#include "FanControl.h"
+#include "ExhaustFilter.h"
+#include "Telemetry.h"
+#include "Pinout.h"
+
+extern SystemData sys;
+extern BurnState  burnState;
+
+/* ============================================================
+ *  PROVISION / BOOT
+ * ============================================================ */
+void core_provision(RunMode mode) {
+    hal_reset();
+    systemdata_init();
+
+    eeprom_saveSetpoint(sys.exhaustSetpoint);
+    eeprom_saveBoostTime(sys.boostTimeSeconds);
+    eeprom_saveDeadband(sys.deadbandF);
+    eeprom_saveClampMin(sys.clampMinPercent);
+    eeprom_saveClampMax(sys.clampMaxPercent);
+    eeprom_saveDeadzone(sys.deadzoneFanMode);
+
+    eeprom_saveEmberGuardianMinutes(sys.emberGuardianTimerMinutes);
+    eeprom_saveFlueLow(sys.flueLowThreshold);
+    eeprom_saveFlueRecovery(sys.flueRecoveryThreshold);
+
+    eeprom_saveEnvSeasonStarts();
+    eeprom_saveEnvSeasonHyst();
+    eeprom_saveEnvSeasonSetpoints();
+
+    eeprom_saveTankLow(sys.tankLowSetpointF);
+    eeprom_saveTankHigh(sys.tankHighSetpointF);
+    eeprom_saveRunMode((uint8_t)mode);
+    eeprom_saveProbeRoles();
+    eeprom_commit();
+}
+
+void core_boot() {
+    pinMode(PIN_DAMPER, OUTPUT);
+    digitalWrite(PIN_DAMPER, HIGH);   // default CLOSED
+    pinMode(PIN_FAN_PWM, OUTPUT);
+
+    systemdata_init();
+    eeprom_init();
+
+    exhfilter_init();
+    sys.waterProbeCount = 1;          // tank probe only
+
+    env_logic_init();
+    burnengine_init();
+    fancontrol_init();
+
+    burnengine_startBoost();
+    burnState = sys.burnState;
+}
+
+/* ============================================================
+ *  PROCESS INPUTS
+ * ============================================================ */
+void core_setProcess(float tankF, float outdoorF) {
+    sys.waterTempF[0] = tankF;
+
+    sys.envSensorOK = !isnan(outdoorF);
+    if (sys.envSensorOK) sys.envTempF = outdoorF;
+}
+
+void core_envTick() {
+    env_logic_update(millis());
+}
+
+/* ============================================================
+ *  CONTROL TICK (task_control)
+ * ============================================================ */
+int core_controlTick(float exhaustRawF) {
+    unsigned long now = millis();
+
+    // exhaust_poll(): one filter step per fresh sample
+    if (isnan(exhaustRawF)) {
+        sys.exhaustSensorOK = false;
+    } else {
+        sys.exhaustSensorOK = true;
+        sys.exhaustRawF     = exhaustRawF;
+        sys.exhaustSmoothF  = exhfilter_push(exhaustRawF, now);
+    }
+
+    int demand     = burnengine_compute();
+    int fanPercent = fancontrol_apply(demand);
+
+    analogWrite(PIN_FAN_PWM, map(fanPercent, 0, 100, 0, 255));
+
+    sys.fanFinal = fanPercent;
+    burnState    = sys.burnState;
+    sys.uptimeMs = now;
+
+    telemetry_capture(now);
+
+    return fanPercent;
+}
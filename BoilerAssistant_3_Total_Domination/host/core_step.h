@@ -0,0 +1,52 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host Core Step API
+ *  ------------------------------------------------------------
+ *  File: host/core_step.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Drives the firmware core on the host the same way the .ino
+ *    does on the board:
+ *
+ *      core_provision()   — factory defaults saved to EEPROM
+ *      core_boot()        — setup() order for the core modules
+ *      core_setProcess()  — tank / outdoor readings into sys.*
+ *      core_controlTick() — task_control(): exhaust sample →
+ *                           filter → burn engine → fan → PWM pin
+ *
+ *    The simulated clock (HalSim.h) is the caller's to advance.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef HOST_CORE_STEP_H
+#define HOST_CORE_STEP_H
+
+#include <Arduino.h>
+#include "SystemData.h"
+
+// Reset the HAL and store systemdata_init() defaults through the
+// regular eeprom_save*() calls, optionally overriding the run mode
+void core_provision(RunMode mode);
+
+// systemdata_init → eeprom_init → filter/env/burn/fan init → BOOST
+void core_boot();
+
+// Tank probe (role PROBE_TANK → probe 0) and BME280 outdoor reading.
+// NaN marks a missing reading.
+void core_setProcess(float tankF, float outdoorF);
+
+// One 250 ms control tick at the current simulated time.
+// exhaustRawF is the fresh MAX31855 sample (NaN = sensor fault).
+// Returns the applied fan percent.
+int core_controlTick(float exhaustRawF);
+
+// Seasonal update (task_environment on the board)
+void core_envTick();
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Control Math Equivalence Case (host)
+ *  ------------------------------------------------------------
+ *  File: host/equiv_case.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    One input vector for the control math equivalence tool and
+ *    the entry points of the per‑mode kernels.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef EQUIV_CASE_H
+#define EQUIV_CASE_H
+
+#include <stdint.h>
+
+#define EQUIV_STAGE_RAMP 0
+#define EQUIV_STAGE_HOLD 1
+
+struct EquivCase {
+    float   exhaustF;
+    int     setpointF;
+    int     deadbandF;
+    int     clampMinPercent;
+    int     clampMaxPercent;
+    uint8_t fanMode;
+    uint8_t stage;
+};
+
+int equiv_kernel_double(const EquivCase* c);
+int equiv_kernel_float(const EquivCase* c);
+int equiv_kernel_fixed(const EquivCase* c);
+
+#endif
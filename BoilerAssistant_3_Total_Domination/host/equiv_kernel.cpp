@@ -0,0 +1,50 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Control Math Equivalence Kernel (host)
+ *  ------------------------------------------------------------
+ *  File: host/equiv_kernel.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Compiled once per CTL_MATH_MODE by host/CMakeLists.txt.
+ *    EQUIV_KERNEL names the exported entry point so all three
+ *    variants link into a single control_math_equiv binary.
+ *
+ *    The kernel mirrors the demand path of burnengine_compute():
+ *    RAMP / HOLD demand followed by the finalize clamp.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "../ControlMath.h"
+#include "equiv_case.h"
+
+#ifndef EQUIV_KERNEL
+#error "EQUIV_KERNEL must name the kernel entry point"
+#endif
+
+int EQUIV_KERNEL(const EquivCase* c) {
+    ctl_t exh = ctl_fromFloat(c->exhaustF);
+    int demand;
+
+    if (c->stage == EQUIV_STAGE_RAMP) {
+        demand = ctl_rampDemand(exh, c->setpointF, c->clampMinPercent);
+    } else {
+        CtlBand band = ctl_holdBand(c->setpointF, c->deadbandF);
+        demand = ctl_holdDemand(exh, band, c->fanMode,
+                                c->clampMinPercent, c->clampMaxPercent);
+    }
+
+    // burnengine_finalize(): clamp only when the fan is on
+    if (demand > 0) {
+        if (demand < c->clampMinPercent) demand = c->clampMinPercent;
+        if (demand > c->clampMaxPercent) demand = c->clampMaxPercent;
+    } else {
+        demand = 0;
+    }
+    return demand;
+}
@@ -0,0 +1,118 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host HAL: Arduino.h stand‑in
+ *  ------------------------------------------------------------
+ *  File: host/hal/Arduino.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    The subset of the Arduino API used by the firmware core
+ *    (BurnEngine, FanControl, EnvironmentalLogic, SystemData,
+ *    SystemState, EEPROMStorage, ExhaustFilter) so those files
+ *    compile unchanged on Linux.
+ *
+ *      • millis() / micros()   — simulated clock (HalSim.h)
+ *      • digitalWrite / analogWrite — recorded per pin
+ *      • map() / constrain()   — Arduino semantics
+ *      • Print / Serial        — stdout
+ *
+ *  Architectural Notes:
+ *      - Never used by the Arduino IDE (host/ is not compiled)
+ *      - No String class: the core modules do not use it
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef HOST_HAL_ARDUINO_H
+#define HOST_HAL_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+
+/* ============================================================
+ *  PINS
+ * ============================================================ */
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+#define HAL_NUM_PINS 20
+
+enum {
+    D0 = 0, D1, D2, D3, D4, D5, D6, D7,
+    D8, D9, D10, D11, D12, D13,
+    A0, A1, A2, A3, A4, A5
+};
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int  digitalRead(int pin);
+void analogWrite(int pin, int value);
+
+/* ============================================================
+ *  TIME
+ * ============================================================ */
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+/* ============================================================
+ *  MATH
+ * ============================================================ */
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+template <typename T, typename L, typename H>
+static inline T constrain(T x, L lo, H hi) {
+    return (x < (T)lo) ? (T)lo : ((x > (T)hi) ? (T)hi : x);
+}
+
+/* ============================================================
+ *  PRINT / SERIAL
+ * ============================================================ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*buf++);
+        return n;
+    }
+
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(int v);
+    size_t print(unsigned int v);
+    size_t print(long v);
+    size_t print(unsigned long v);
+    size_t print(double v, int digits = 2);
+
+    size_t println();
+    template <typename T>
+    size_t println(T v) { size_t n = print(v); return n + println(); }
+    size_t println(double v, int digits) { size_t n = print(v, digits); return n + println(); }
+};
+
+class HalSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    operator bool() const { return true; }
+};
+
+extern HalSerial Serial;
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host HAL: EEPROM.h stand‑in
+ *  ------------------------------------------------------------
+ *  File: host/hal/EEPROM.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    In‑memory EEPROM with the same API as the UNO R4 core.
+ *    Size matches the RA4M1 data flash (8 KB). Contents start
+ *    erased (0xFF) and can be inspected / preset via HalSim.h.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef HOST_HAL_EEPROM_H
+#define HOST_HAL_EEPROM_H
+
+#include "Arduino.h"
+
+#define HAL_EEPROM_SIZE 8192
+
+class EEPROMClass {
+public:
+    uint8_t  read(int addr);
+    void     write(int addr, uint8_t value);
+    void     update(int addr, uint8_t value);
+    uint16_t length() { return HAL_EEPROM_SIZE; }
+
+    template <typename T>
+    T& get(int addr, T& t) {
+        uint8_t* p = (uint8_t*)&t;
+        for (size_t i = 0; i < sizeof(T); i++) p[i] = read(addr + (int)i);
+        return t;
+    }
+
+    template <typename T>
+    const T& put(int addr, const T& t) {
+        const uint8_t* p = (const uint8_t*)&t;
+        for (size_t i = 0; i < sizeof(T); i++) update(addr + (int)i, p[i]);
+        return t;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
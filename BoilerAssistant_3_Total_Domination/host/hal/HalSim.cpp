@@ -0,0 +1,170 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host HAL Implementation
+ *  ------------------------------------------------------------
+ *  File: host/hal/HalSim.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Backing store for the Arduino.h / EEPROM.h stand‑ins:
+ *    a simulated µs clock, per‑pin write recorders, an 8 KB
+ *    EEPROM image and a stdout Serial.
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "HalSim.h"
+
+#include <stdarg.h>
+
+/* ============================================================
+ *  INTERNAL STATE
+ * ============================================================ */
+static unsigned long long nowUs = 0;
+static HalPin   pins[HAL_NUM_PINS];
+static int      inputs[HAL_NUM_PINS];
+static uint8_t  eepromImage[HAL_EEPROM_SIZE];
+static bool     eepromReady = false;
+static uint32_t eepromWriteCount = 0;
+
+HalSerial   Serial;
+EEPROMClass EEPROM;
+
+static bool validPin(int pin) {
+    return pin >= 0 && pin < HAL_NUM_PINS;
+}
+
+/* ============================================================
+ *  CLOCK
+ * ============================================================ */
+unsigned long millis() { return (unsigned long)(uint32_t)(nowUs / 1000ULL); }
+unsigned long micros() { return (unsigned long)(uint32_t)nowUs; }
+
+void delay(unsigned long ms)             { nowUs += (unsigned long long)ms * 1000ULL; }
+void delayMicroseconds(unsigned int us)  { nowUs += us; }
+
+void hal_setMillis(unsigned long ms)     { nowUs = (unsigned long long)ms * 1000ULL; }
+void hal_advanceMillis(unsigned long ms) { nowUs += (unsigned long long)ms * 1000ULL; }
+void hal_advanceMicros(unsigned long us) { nowUs += us; }
+
+/* ============================================================
+ *  PINS
+ * ============================================================ */
+void pinMode(int pin, int mode) {
+    if (validPin(pin)) pins[pin].mode = mode;
+}
+
+void digitalWrite(int pin, int value) {
+    if (!validPin(pin)) return;
+    pins[pin].digital = value ? HIGH : LOW;
+    pins[pin].digitalWrites++;
+}
+
+int digitalRead(int pin) {
+    if (!validPin(pin)) return LOW;
+    if (pins[pin].mode == OUTPUT) return pins[pin].digital;
+    return inputs[pin];
+}
+
+void analogWrite(int pin, int value) {
+    if (!validPin(pin)) return;
+    pins[pin].analog = value;
+    pins[pin].analogWrites++;
+}
+
+const HalPin* hal_pin(int pin) {
+    return validPin(pin) ? &pins[pin] : nullptr;
+}
+
+void hal_resetPins() {
+    memset(pins, 0, sizeof(pins));
+    for (int i = 0; i < HAL_NUM_PINS; i++) inputs[i] = HIGH;
+}
+
+void hal_setInput(int pin, int value) {
+    if (validPin(pin)) inputs[pin] = value ? HIGH : LOW;
+}
+
+/* ============================================================
+ *  MATH
+ * ============================================================ */
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/* ============================================================
+ *  EEPROM
+ * ============================================================ */
+void hal_eepromErase() {
+    memset(eepromImage, 0xFF, sizeof(eepromImage));
+    eepromReady      = true;
+    eepromWriteCount = 0;
+}
+
+uint8_t* hal_eepromData() {
+    if (!eepromReady) hal_eepromErase();
+    return eepromImage;
+}
+
+uint32_t hal_eepromWrites() {
+    return eepromWriteCount;
+}
+
+uint8_t EEPROMClass::read(int addr) {
+    if (addr < 0 || addr >= HAL_EEPROM_SIZE) return 0xFF;
+    return hal_eepromData()[addr];
+}
+
+void EEPROMClass::write(int addr, uint8_t value) {
+    if (addr < 0 || addr >= HAL_EEPROM_SIZE) return;
+    hal_eepromData()[addr] = value;
+    eepromWriteCount++;
+}
+
+void EEPROMClass::update(int addr, uint8_t value) {
+    if (read(addr) != value) write(addr, value);
+}
+
+/* ============================================================
+ *  RESET
+ * ============================================================ */
+void hal_reset() {
+    nowUs = 0;
+    hal_resetPins();
+    hal_eepromErase();
+}
+
+/* ============================================================
+ *  PRINT / SERIAL
+ * ============================================================ */
+size_t HalSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t Print::print(const char* s) {
+    size_t n = 0;
+    while (*s) n += write((uint8_t)*s++);
+    return n;
+}
+
+size_t Print::print(char c)           { return write((uint8_t)c); }
+
+static size_t printFmt(Print* p, const char* fmt, ...) {
+    char buf[48];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    return p->print(buf);
+}
+
+size_t Print::print(int v)             { return printFmt(this, "%d", v); }
+size_t Print::print(unsigned int v)    { return printFmt(this, "%u", v); }
+size_t Print::print(long v)            { return printFmt(this, "%ld", v); }
+size_t Print::print(unsigned long v)   { return printFmt(this, "%lu", v); }
+size_t Print::print(double v, int d)   { return printFmt(this, "%.*f", d, v); }
+size_t Print::println()                { return print("\r\n"); }
@@ -0,0 +1,56 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Host HAL: Simulation Controls
+ *  ------------------------------------------------------------
+ *  File: host/hal/HalSim.h
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Test‑side handle on the host HAL:
+ *
+ *      • simulated clock (set / advance; delay() advances it)
+ *      • last value + write count of every digital / PWM pin
+ *      • direct access to the in‑memory EEPROM image
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#ifndef HOST_HAL_SIM_H
+#define HOST_HAL_SIM_H
+
+#include "Arduino.h"
+#include "EEPROM.h"
+
+struct HalPin {
+    int      mode;
+    int      digital;      // last digitalWrite() value
+    int      analog;       // last analogWrite() value
+    uint32_t digitalWrites;
+    uint32_t analogWrites;
+};
+
+// Clock (µs resolution; millis() = µs / 1000)
+void          hal_setMillis(unsigned long ms);
+void          hal_advanceMillis(unsigned long ms);
+void          hal_advanceMicros(unsigned long us);
+
+// Pins
+const HalPin* hal_pin(int pin);
+void          hal_resetPins();
+
+// Digital inputs seen by digitalRead()
+void          hal_setInput(int pin, int value);
+
+// EEPROM image
+uint8_t*      hal_eepromData();
+void          hal_eepromErase();          // fill with 0xFF
+uint32_t      hal_eepromWrites();
+
+// Reset clock, pins and EEPROM
+void          hal_reset();
+
+#endif
@@ -0,0 +1,358 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Closed‑Loop Plant Simulator (host)
+ *  ------------------------------------------------------------
+ *  File: host/plant_sim.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Couples the firmware core (burnengine_compute → fancontrol_
+ *    apply, via core_step.h) to the BoilerPlant model and runs a
+ *    multi‑hour burn at the real 250 ms control period, as fast as
+ *    the host allows. Used to compare deadband, clamp and seasonal
+ *    settings without burning real wood.
+ *
+ *    Per tick:
+ *      plant flue temp (+ probe noise) → core_controlTick()
+ *      fan % + damper pin            → plant_step(0.25 s)
+ *
+ *    Report:
+ *      • fuel used (lb) and heat released / delivered
+ *      • flue time in band (HOLD within ±deadband/2)
+ *      • tank time in band (tank low … tank high)
+ *      • fan‑duty integral (%·h and full‑fan hours)
+ *      • Ember Guardian trips and time per burn state
+ *
+ *  Usage:
+ *      plant_sim [options]
+ *        --hours H            simulated duration        (24)
+ *        --mode auto|continuous                         (auto)
+ *        --setpoint F         exhaust setpoint
+ *        --deadband F
+ *        --clamp-min P  --clamp-max P
+ *        --fan-mode 0|1       deadzone fan mode
+ *        --tank-low F   --tank-high F
+ *        --guardian-min M  --flue-low F  --flue-recovery F
+ *        --seasonal           enable auto season (outdoor driven)
+ *        --outdoor F          outdoor mean              (25)
+ *        --swing F            outdoor daily swing       (10)
+ *        --load LB            initial fuel load         (250)
+ *        --reload-hours H     reload + BOOST every H    (off)
+ *        --reload-lb LB       fuel per reload           (120)
+ *        --noise F            probe noise ±F            (2)
+ *        --csv FILE           one row per simulated minute
+ *        --trace FILE         raw sensor trace for replay_trace
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "BoilerPlant.h"
+#include "Trace.h"
+#include "core_step.h"
+#include "HalSim.h"
+
+#include "SystemState.h"
+#include "EEPROMStorage.h"
+#include "BurnEngine.h"
+#include "Pinout.h"
+
+#include <chrono>
+#include <stdlib.h>
+
+extern SystemData sys;
+
+static const unsigned long TICK_MS  = 250;
+static const unsigned long ENV_MS   = 3000;   // task_environment period
+
+/* ============================================================
+ *  OPTIONS
+ * ============================================================ */
+struct SimOptions {
+    float   hours        = 24.0f;
+    RunMode mode         = RUNMODE_AUTO_TANK;
+
+    // -1 = keep firmware default
+    int setpoint = -1, deadband = -1, clampMin = -1, clampMax = -1;
+    int fanMode = -1, tankLow = -1, tankHigh = -1;
+    int guardianMin = -1, flueLow = -1, flueRecovery = -1;
+
+    bool  seasonal     = false;
+    float loadLb       = 250.0f;
+    float reloadHours  = 0.0f;
+    float reloadLb     = 120.0f;
+    float noiseF       = 2.0f;
+    const char* csv    = nullptr;
+    const char* trace  = nullptr;
+};
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+        "usage: %s [--hours H] [--mode auto|continuous] [--setpoint F]\n"
+        "          [--deadband F] [--clamp-min P] [--clamp-max P] [--fan-mode 0|1]\n"
+        "          [--tank-low F] [--tank-high F] [--guardian-min M]\n"
+        "          [--flue-low F] [--flue-recovery F] [--seasonal]\n"
+        "          [--outdoor F] [--swing F] [--load LB] [--reload-hours H]\n"
+        "          [--reload-lb LB] [--noise F] [--csv FILE] [--trace FILE]\n", prog);
+}
+
+static bool parseArgs(int argc, char** argv, SimOptions& o, PlantParams& p) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        #define OPT_F(name, dst) if (!strcmp(a, name) && v) { dst = (float)atof(v); i++; continue; }
+        #define OPT_I(name, dst) if (!strcmp(a, name) && v) { dst = atoi(v); i++; continue; }
+
+        OPT_F("--hours",         o.hours)
+        OPT_I("--setpoint",      o.setpoint)
+        OPT_I("--deadband",      o.deadband)
+        OPT_I("--clamp-min",     o.clampMin)
+        OPT_I("--clamp-max",     o.clampMax)
+        OPT_I("--fan-mode",      o.fanMode)
+        OPT_I("--tank-low",      o.tankLow)
+        OPT_I("--tank-high",     o.tankHigh)
+        OPT_I("--guardian-min",  o.guardianMin)
+        OPT_I("--flue-low",      o.flueLow)
+        OPT_I("--flue-recovery", o.flueRecovery)
+        OPT_F("--outdoor",       p.outdoorMeanF)
+        OPT_F("--swing",         p.outdoorSwingF)
+        OPT_F("--load",          o.loadLb)
+        OPT_F("--reload-hours",  o.reloadHours)
+        OPT_F("--reload-lb",     o.reloadLb)
+        OPT_F("--noise",         o.noiseF)
+
+        #undef OPT_F
+        #undef OPT_I
+
+        if (!strcmp(a, "--mode") && v) {
+            if      (!strcmp(v, "auto"))       o.mode = RUNMODE_AUTO_TANK;
+            else if (!strcmp(v, "continuous")) o.mode = RUNMODE_CONTINUOUS;
+            else return false;
+            i++;
+            continue;
+        }
+        if (!strcmp(a, "--seasonal")) { o.seasonal = true; continue; }
+        if (!strcmp(a, "--csv") && v)  { o.csv = v; i++; continue; }
+        if (!strcmp(a, "--trace") && v) { o.trace = v; i++; continue; }
+
+        return false;
+    }
+    return o.hours > 0.0f;
+}
+
+// Operator settings go through EEPROM so eeprom_init() sanity
+// clamps apply exactly as on the board
+static void applySettings(const SimOptions& o) {
+    if (o.setpoint     >= 0) eeprom_saveSetpoint(o.setpoint);
+    if (o.deadband     >= 0) eeprom_saveDeadband(o.deadband);
+    if (o.clampMin     >= 0) eeprom_saveClampMin(o.clampMin);
+    if (o.clampMax     >= 0) eeprom_saveClampMax(o.clampMax);
+    if (o.fanMode      >= 0) eeprom_saveDeadzone(o.fanMode);
+    if (o.tankLow      >= 0) eeprom_saveTankLow(o.tankLow);
+    if (o.tankHigh     >= 0) eeprom_saveTankHigh(o.tankHigh);
+    if (o.guardianMin  >= 0) eeprom_saveEmberGuardianMinutes(o.guardianMin);
+    if (o.flueLow      >= 0) eeprom_saveFlueLow(o.flueLow);
+    if (o.flueRecovery >= 0) eeprom_saveFlueRecovery(o.flueRecovery);
+}
+
+/* ============================================================
+ *  PROBE NOISE (deterministic)
+ * ============================================================ */
+static uint32_t noiseState = 0x2545F491u;
+
+static float probeNoise(float amp) {
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    float u = (float)(noiseState & 0xFFFFu) / 65535.0f;   // 0..1
+    return (2.0f * u - 1.0f) * amp;
+}
+
+static const char* stateName(BurnState s) {
+    switch (s) {
+        case BURN_IDLE:        return "IDLE";
+        case BURN_RAMP:        return "RAMP";
+        case BURN_HOLD:        return "HOLD";
+        case BURN_BOOST:       return "BOOST";
+        case BURN_EMBER_GUARD: return "EMBER_GUARD";
+    }
+    return "?";
+}
+
+/* ============================================================
+ *  MAIN
+ * ============================================================ */
+int main(int argc, char** argv) {
+    SimOptions  opt;
+    PlantParams pp;
+    plant_defaults(pp);
+
+    if (!parseArgs(argc, argv, opt, pp)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE* csv = nullptr;
+    if (opt.csv) {
+        csv = fopen(opt.csv, "w");
+        if (!csv) {
+            perror(opt.csv);
+            return 1;
+        }
+        fprintf(csv, "t_h,state,fan,damper,flue_f,smooth_f,water_f,outdoor_f,fuel_lb\n");
+    }
+
+    FILE* trace = nullptr;
+    if (opt.trace) {
+        trace = fopen(opt.trace, "w");
+        if (!trace) {
+            perror(opt.trace);
+            return 1;
+        }
+        trace_writeCsvHeader(trace);
+    }
+
+    // Firmware
+    core_provision(opt.mode);
+    applySettings(opt);
+    core_boot();
+
+    if (opt.seasonal) {
+        sys.envAutoSeasonEnabled = true;
+    }
+
+    // Plant: start a little below tank low so AUTO TANK fires at once
+    PlantState ps;
+    const float startHour = 6.0f;
+    plant_init(ps, pp, opt.loadLb, (float)sys.tankLowSetpointF - 5.0f, startHour);
+    core_setProcess(ps.waterF, ps.outdoorF);
+    core_envTick();
+
+    const unsigned long long totalTicks =
+        (unsigned long long)(opt.hours * 3600.0f * 1000.0f / TICK_MS);
+    const unsigned long long reloadTicks =
+        (opt.reloadHours > 0.0f)
+        ? (unsigned long long)(opt.reloadHours * 3600.0f * 1000.0f / TICK_MS)
+        : 0ULL;
+
+    // Metrics
+    unsigned long long stateTicks[5] = { 0 };
+    unsigned long long firingTicks   = 0;
+    unsigned long long flueBandTicks = 0;
+    unsigned long long tankBandTicks = 0;
+    double   fanPctSeconds = 0.0;
+    uint32_t guardianTrips = 0;
+    uint32_t reloads       = 0;
+    float    waterMin = ps.waterF, waterMax = ps.waterF;
+    bool     prevLatched = sys.emberGuardianLatched;
+
+    const float dtS = (float)TICK_MS / 1000.0f;
+    unsigned long lastEnvMs = millis();
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (unsigned long long tick = 0; tick < totalTicks; tick++) {
+        hal_advanceMillis(TICK_MS);
+        unsigned long now = millis();
+
+        float tod = fmodf(startHour + (float)((double)tick * dtS / 3600.0), 24.0f);
+
+        // Operator reload + BOOST
+        if (reloadTicks && tick > 0 && tick % reloadTicks == 0) {
+            plant_load(ps, opt.reloadLb);
+            burnengine_startBoost();
+            reloads++;
+        }
+
+        // Sensors → firmware
+        core_setProcess(ps.waterF, ps.outdoorF);
+        if (now - lastEnvMs >= ENV_MS) {
+            lastEnvMs = now;
+            core_envTick();
+        }
+
+        float probeF = ps.flueF + probeNoise(opt.noiseF);
+        if (trace) {
+            TraceSample ts = { (uint32_t)(tick * TICK_MS), probeF, ps.waterF, ps.outdoorF };
+            trace_writeCsvSample(trace, ts);
+        }
+
+        int  fan  = core_controlTick(probeF);
+        bool open = hal_pin(PIN_DAMPER)->digital == LOW;
+
+        // Firmware → plant
+        plant_step(ps, pp, dtS, fan, open, tod);
+
+        // Metrics
+        BurnState st = sys.burnState;
+        if ((unsigned)st < 5) stateTicks[st]++;
+
+        if (st == BURN_BOOST || st == BURN_RAMP || st == BURN_HOLD) {
+            firingTicks++;
+            float half = sys.deadbandF / 2.0f;
+            if (st == BURN_HOLD &&
+                fabsf(sys.exhaustSmoothF - (float)sys.exhaustSetpoint) <= half) {
+                flueBandTicks++;
+            }
+        }
+
+        if (ps.waterF >= sys.tankLowSetpointF && ps.waterF <= sys.tankHighSetpointF) {
+            tankBandTicks++;
+        }
+        if (ps.waterF < waterMin) waterMin = ps.waterF;
+        if (ps.waterF > waterMax) waterMax = ps.waterF;
+
+        fanPctSeconds += (double)fan * dtS;
+
+        if (sys.emberGuardianLatched && !prevLatched) guardianTrips++;
+        prevLatched = sys.emberGuardianLatched;
+
+        if (csv && (now % 60000UL) == 0) {
+            fprintf(csv, "%.4f,%s,%d,%d,%.1f,%.1f,%.2f,%.1f,%.2f\n",
+                    (double)now / 3600000.0, stateName(st), fan, open ? 1 : 0,
+                    ps.flueF, sys.exhaustSmoothF, ps.waterF, ps.outdoorF, ps.fuelLb);
+        }
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    double wall = std::chrono::duration<double>(t1 - t0).count();
+    if (csv) fclose(csv);
+    if (trace) fclose(trace);
+
+    /* ---------------- Report ---------------- */
+    double simH = (double)totalTicks * dtS / 3600.0;
+
+    printf("plant_sim: %.1f h, %s, setpoint %d F, deadband %d F, clamp %d..%d %%, fan mode %u%s\n",
+           simH, opt.mode == RUNMODE_AUTO_TANK ? "auto tank" : "continuous",
+           sys.exhaustSetpoint, sys.deadbandF,
+           sys.clampMinPercent, sys.clampMaxPercent, sys.deadzoneFanMode,
+           opt.seasonal ? ", seasonal" : "");
+    printf("  outdoor             : %.1f F mean, ±%.1f F\n",
+           pp.outdoorMeanF, pp.outdoorSwingF);
+    printf("  fuel used           : %.1f lb (%.2f MBTU released), %u reloads, %.1f lb left\n",
+           ps.fuelBurnedLb, ps.heatReleasedBtu / 1e6, reloads, ps.fuelLb);
+    printf("  heat delivered      : %.2f MBTU\n", ps.heatDeliveredBtu / 1e6);
+    printf("  flue time in band   : %.1f %% of firing time (%.2f h firing)\n",
+           firingTicks ? 100.0 * (double)flueBandTicks / (double)firingTicks : 0.0,
+           (double)firingTicks * dtS / 3600.0);
+    printf("  tank time in band   : %.1f %% (%d..%d F), min %.1f F, max %.1f F\n",
+           100.0 * (double)tankBandTicks / (double)totalTicks,
+           sys.tankLowSetpointF, sys.tankHighSetpointF, waterMin, waterMax);
+    printf("  fan-duty integral   : %.1f %%·h (%.2f full-fan hours)\n",
+           fanPctSeconds / 3600.0, fanPctSeconds / 360000.0);
+    printf("  Ember Guardian trips: %u\n", guardianTrips);
+    for (int s = 0; s < 5; s++) {
+        if (stateTicks[s]) {
+            printf("  time in %-12s: %.2f h\n", stateName((BurnState)s),
+                   (double)stateTicks[s] * dtS / 3600.0);
+        }
+    }
+    printf("  wall time           : %.3f s (%.0fx real time)\n",
+           wall, wall > 0 ? simH * 3600.0 / wall : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*
+ * ============================================================
+ *  Boiler Assistant – Trace Replay Harness (host)
+ *  ------------------------------------------------------------
+ *  File: host/replay_trace.cpp
+ *  Author: The Architect Collective
+ *  Maintainer: Karl (Embedded Systems Architect)
+ *  License: CC BY-NC-SA 4.0
+ *
+ *  Description:
+ *    Replays a recorded sensor trace (Trace.h) through the exact
+ *    v3 control pipeline and checks the result against a golden
+ *    timeline before a firmware change is flashed.
+ *
+ *    Pipeline per 250 ms control tick (core_controlTick):
+ *      latest trace sample ≤ now (sample‑and‑hold, matching the
+ *      250 ms exhaust_readF_cached() cache)
+ *        → ExhaustFilter (one step per fresh sample)
+ *        → burnengine_compute() → fancontrol_apply() / fan_compute()
+ *
+ *    Input semantics:
+ *      exhaust_raw_f  NaN = thermocouple fault (sensor not OK)
+ *      tank_f         value as published (sys.waterTempF, smoothed);
+ *                     NaN = no reading, previous value held
+ *      outdoor_f      BME280 °F; NaN = no reading, previous held
+ *
+ *    Timeline output (one row per change, plus the first tick):
+ *      t_ms,state,fan,damper
+ *
+ *  Usage:
+ *      replay_trace TRACE [--mode auto|continuous]
+ *                         [--out FILE] [--golden FILE]
+ *                         [--full] [--repeat N] [--to-bin FILE]
+ *
+ *    Exit code: 0 = match (or no golden), 1 = timeline differs,
+ *               2 = usage / I/O error
+ *
+ *  Version:
+ *      Boiler Assistant v3.0 "Total Domination"
+ * ============================================================
+ */
+
+#include "Trace.h"
+#include "core_step.h"
+#include "HalSim.h"
+
+#include "SystemState.h"
+#include "Pinout.h"
+
+#include <chrono>
+#include <stdlib.h>
+#include <string>
+
+extern SystemData sys;
+
+static const unsigned long TICK_MS = 250;
+static const unsigned long ENV_MS  = 3000;
+
+static const char* stateName(BurnState s) {
+    switch (s) {
+        case BURN_IDLE:        return "IDLE";
+        case BURN_RAMP:        return "RAMP";
+        case BURN_HOLD:        return "HOLD";
+        case BURN_BOOST:       return "BOOST";
+        case BURN_EMBER_GUARD: return "EMBER_GUARD";
+    }
+    return "?";
+}
+
+/* ============================================================
+ *  REPLAY
+ * ============================================================ */
+struct ReplayStats {
+    unsigned long long ticks;
+    unsigned long long samples;
+};
+
+// One full pass. Timeline rows are appended to `timeline` when non‑null.
+static ReplayStats replay(const std::vector<TraceSample>& trace,
+                          RunMode mode, bool full,
+                          std::vector<std::string>* timeline)
+{
+    ReplayStats st = { 0, 0 };
+    if (trace.empty()) return st;
+
+    core_provision(mode);
+    core_boot();
+
+    const uint32_t t0   = trace.front().tMs;
+    const uint32_t tEnd = trace.back().tMs;
+
+    float exhaustF = NAN;
+    float tankF    = NAN;
+    float outdoorF = NAN;
+
+    size_t next = 0;
+    unsigned long lastEnvMs = 0;
+
+    BurnState prevState  = (BurnState)255;
+    int       prevFan    = -1;
+    int       prevDamper = -1;
+
+    char row[64];
+
+    for (uint32_t t = 0; t0 + t <= tEnd; t += TICK_MS) {
+        hal_setMillis(TICK_MS + t);       // boot takes the first tick
+
+        // Consume every trace sample up to now (sample‑and‑hold)
+        while (next < trace.size() && trace[next].tMs - t0 <= t) {
+            const TraceSample& s = trace[next++];
+            exhaustF = s.exhaustRawF;
+            if (!isnan(s.tankF))    tankF    = s.tankF;
+            if (!isnan(s.outdoorF)) outdoorF = s.outdoorF;
+            st.samples++;
+        }
+
+        core_setProcess(tankF, outdoorF);
+        if (t - lastEnvMs >= ENV_MS) {
+            lastEnvMs = t;
+            core_envTick();
+        }
+
+        int fan    = core_controlTick(exhaustF);
+        int damper = hal_pin(PIN_DAMPER)->digital == LOW ? 1 : 0;   // 1 = open
+        st.ticks++;
+
+        if (timeline &&
+            (full || sys.burnState != prevState || fan != prevFan || damper != prevDamper))
+        {
+            snprintf(row, sizeof(row), "%lu,%s,%d,%d",
+                     (unsigned long)t, stateName(sys.burnState), fan, damper);
+            timeline->push_back(row);
+        }
+
+        prevState  = sys.burnState;
+        prevFan    = fan;
+        prevDamper = damper;
+    }
+
+    return st;
+}
+
+/* ============================================================
+ *  GOLDEN DIFF
+ * ============================================================ */
+static bool readLines(const char* path, std::vector<std::string>& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        size_t n = strlen(line);
+        while (n && (line[n - 1] == '\n' || line[n - 1] == '\r')) line[--n] = '\0';
+        if (n == 0 || line[0] == '#' || !strncmp(line, "t_ms", 4)) continue;
+        out.push_back(line);
+    }
+    fclose(f);
+    return true;
+}
+
+static size_t diffTimeline(const std::vector<std::string>& got,
+                           const std::vector<std::string>& golden)
+{
+    const size_t SHOW = 10;
+    size_t diffs = 0;
+    size_t n = got.size() > golden.size() ? got.size() : golden.size();
+
+    for (size_t i = 0; i < n; i++) {
+        const char* g = (i < golden.size()) ? golden[i].c_str() : "<missing>";
+        const char* r = (i < got.size())    ? got[i].c_str()    : "<missing>";
+        if (!strcmp(g, r)) continue;
+
+        if (diffs < SHOW) {
+            printf("  row %zu\n    golden: %s\n    replay: %s\n", i + 1, g, r);
+        }
+        diffs++;
+    }
+
+    if (diffs > SHOW) printf("  … %zu more differing rows\n", diffs - SHOW);
+    return diffs;
+}
+
+/* ============================================================
+ *  MAIN
+ * ============================================================ */
+static void usage(const char* prog) {
+    fprintf(stderr,
+        "usage: %s TRACE [--mode auto|continuous] [--out FILE] [--golden FILE]\n"
+        "                [--full] [--repeat N] [--to-bin FILE]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    const char* tracePath  = nullptr;
+    const char* outPath    = nullptr;
+    const char* goldenPath = nullptr;
+    const char* binPath    = nullptr;
+    RunMode     mode       = RUNMODE_AUTO_TANK;
+    bool        full       = false;
+    int         repeat     = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if      (!strcmp(a, "--out")    && v) { outPath = v; i++; }
+        else if (!strcmp(a, "--golden") && v) { goldenPath = v; i++; }
+        else if (!strcmp(a, "--to-bin") && v) { binPath = v; i++; }
+        else if (!strcmp(a, "--repeat") && v) { repeat = atoi(v); i++; }
+        else if (!strcmp(a, "--full"))        { full = true; }
+        else if (!strcmp(a, "--mode")   && v) {
+            if      (!strcmp(v, "auto"))       mode = RUNMODE_AUTO_TANK;
+            else if (!strcmp(v, "continuous")) mode = RUNMODE_CONTINUOUS;
+            else { usage(argv[0]); return 2; }
+            i++;
+        }
+        else if (a[0] != '-' && !tracePath)   { tracePath = a; }
+        else { usage(argv[0]); return 2; }
+    }
+
+    if (!tracePath || repeat < 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<TraceSample> trace;
+    if (!trace_load(tracePath, trace)) return 2;
+
+    if (binPath && !trace_saveBin(binPath, trace)) return 2;
+
+    // Reference pass (timeline), then timed passes
+    std::vector<std::string> timeline;
+    ReplayStats st = replay(trace, mode, full, &timeline);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++) replay(trace, mode, full, nullptr);
+    auto t1 = std::chrono::steady_clock::now();
+    double wall = std::chrono::duration<double>(t1 - t0).count();
+
+    printf("replay_trace: %s (%s)\n", tracePath,
+           mode == RUNMODE_AUTO_TANK ? "auto tank" : "continuous");
+    printf("  samples         : %llu\n", st.samples);
+    printf("  control ticks   : %llu (%.2f h)\n",
+           st.ticks, (double)st.ticks * TICK_MS / 3600000.0);
+    printf("  timeline rows   : %zu\n", timeline.size());
+    printf("  replay rate     : %.0f samples/s, %.0f ticks/s (%d pass%s)\n",
+           wall > 0 ? (double)st.samples * repeat / wall : 0.0,
+           wall > 0 ? (double)st.ticks * repeat / wall : 0.0,
+           repeat, repeat == 1 ? "" : "es");
+
+    if (outPath) {
+        FILE* f = fopen(outPath, "w");
+        if (!f) {
+            perror(outPath);
+            return 2;
+        }
+        fprintf(f, "t_ms,state,fan,damper\n");
+        for (size_t i = 0; i < timeline.size(); i++) {
+            fprintf(f, "%s\n", timeline[i].c_str());
+        }
+        fclose(f);
+    }
+
+    if (goldenPath) {
+        std::vector<std::string> golden;
+        if (!readLines(goldenPath, golden)) return 2;
+
+        size_t diffs = diffTimeline(timeline, golden);
+        if (diffs) {
+            printf("  golden          : FAIL (%zu differing rows)\n", diffs);
+            return 1;
+        }
+        printf("  golden          : match\n");
+    }
+
+    return 0;
+}